@@ -0,0 +1,37 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "AsyncAction_FindTargetablePoints.h"
+
+#include "TargetingSystemComponent.h"
+#include "Filter/TargetPointFilterBase.h"
+
+UAsyncAction_FindTargetablePoints* UAsyncAction_FindTargetablePoints::FindTargetablePointsAsync(UTargetingSystemComponent* TargetingSystemComponent, const TArray<UTargetPointFilterBase*>& Filters)
+{
+	UAsyncAction_FindTargetablePoints* Action = NewObject<UAsyncAction_FindTargetablePoints>();
+	Action->TargetingSystemComponent = TargetingSystemComponent;
+	Action->Filters = Filters;
+	if (IsValid(TargetingSystemComponent))
+	{
+		Action->RegisterWithGameInstance(TargetingSystemComponent);
+	}
+	return Action;
+}
+
+void UAsyncAction_FindTargetablePoints::Activate()
+{
+	if (!IsValid(TargetingSystemComponent))
+	{
+		HandleCompleted(TArray<UTargetPointComponent*>());
+		return;
+	}
+
+	TargetingSystemComponent->AsyncGetTargetablePoints(ToRawPtrTArrayUnsafe(Filters),
+		FTargetingSystemCompTargetPointsDelegate::CreateUObject(this, &UAsyncAction_FindTargetablePoints::HandleCompleted));
+}
+
+void UAsyncAction_FindTargetablePoints::HandleCompleted(const TArray<UTargetPointComponent*>& TargetPoints)
+{
+	OnCompleted.Broadcast(TargetPoints);
+	SetReadyToDestroy();
+}
@@ -3,8 +3,171 @@
 
 #include "Filter/TargetPointFilterBase.h"
 
+#include "TargetPointQueryTypes.h"
+#include "TargetingSystemStats.h"
+#include "Algo/StableSort.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Blueprint Filter Invocations"), STAT_TargetingSystem_BlueprintFilterInvocations, STATGROUP_TargetingSystem);
+
+void UTargetPointFilterBase::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	bHasBlueprintFilter = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UTargetPointFilterBase, K2_FilterTargetPoints));
+}
 
 void UTargetPointFilterBase::FilterTargetPoints(const AActor* SourceActor, TArray<UTargetPointComponent*>& TargetPoints) const
 {
+	if (HasNativePredicate() && IsValid(SourceActor))
+	{
+		FTargetPointCandidateList Candidates;
+		Candidates.AppendPoints(TargetPoints);
+
+		TArray<uint8, TInlineAllocator<256>> Pass;
+		Pass.Init(1, Candidates.Num());
+		EvaluatePredicate(FTargetPointFilterContext(SourceActor), Candidates, Pass);
+		Candidates.Compact(Pass);
+
+		TargetPoints.Reset();
+		TargetPoints.Append(Candidates.Points);
+	}
+
+	if (ImplementsBlueprintFilter())
+	{
+		CallBlueprintFilter(SourceActor, TargetPoints);
+	}
+}
+
+int32 UTargetPointFilterBase::EvaluatePredicate(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, TArrayView<uint8> InOutPass) const
+{
+	int32 NumPassing = 0;
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		if (InOutPass[Index])
+		{
+			InOutPass[Index] = PassesFilter(Context, Candidates, Index) ? 1 : 0;
+			NumPassing += InOutPass[Index];
+		}
+	}
+	return NumPassing;
+}
+
+float UTargetPointFilterBase::GetFilterCost() const
+{
+	// Array based filters have to copy the candidates, and going through the Blueprint VM costs far more than any
+	// native test.
+	float Cost = HasNativePredicate() ? 1.f : 10.f;
+	if (ImplementsBlueprintFilter())
+	{
+		Cost += 100.f;
+	}
+	return Cost;
+}
+
+bool UTargetPointFilterBase::CanReorder() const
+{
+	return HasNativePredicate() && !ImplementsBlueprintFilter();
+}
+
+void UTargetPointFilterBase::ApplyFilters(const AActor* SourceActor, TConstArrayView<UTargetPointFilterBase*> Filters, FTargetPointCandidateList& Candidates)
+{
+	if (Candidates.IsEmpty() || !IsValid(SourceActor))
+	{
+		return;
+	}
+
+	// Sort each run of reorderable filters by cost. Filters that can't be reordered split the runs, so nothing moves
+	// across them.
+	TArray<const UTargetPointFilterBase*, TInlineAllocator<8>> SortedFilters;
+	int32 RunStart = 0;
+	auto SortRun = [&SortedFilters, &RunStart](int32 RunEnd)
+	{
+		if (RunEnd - RunStart > 1)
+		{
+			Algo::StableSortBy(MakeArrayView(SortedFilters).Slice(RunStart, RunEnd - RunStart),
+				[](const UTargetPointFilterBase* Filter) { return Filter->GetFilterCost(); });
+		}
+	};
+
+	for (const UTargetPointFilterBase* Filter : Filters)
+	{
+		if (!IsValid(Filter))
+		{
+			continue;
+		}
+
+		if (Filter->CanReorder())
+		{
+			SortedFilters.Add(Filter);
+		}
+		else
+		{
+			SortRun(SortedFilters.Num());
+			SortedFilters.Add(Filter);
+			RunStart = SortedFilters.Num();
+		}
+	}
+	SortRun(SortedFilters.Num());
+
+	const FTargetPointFilterContext Context(SourceActor);
+	TArray<uint8, TInlineAllocator<256>> Pass;
+	Pass.Init(1, Candidates.Num());
+	bool bHasRejected = false;
+
+	for (const UTargetPointFilterBase* Filter : SortedFilters)
+	{
+		const bool bHasNativePredicate = Filter->HasNativePredicate();
+		if (bHasNativePredicate)
+		{
+			const int32 NumPassing = Filter->EvaluatePredicate(Context, Candidates, Pass);
+			if (NumPassing == 0)
+			{
+				Candidates.Reset();
+				return;
+			}
+			bHasRejected |= NumPassing != Candidates.Num();
+		}
+
+		if (!bHasNativePredicate || Filter->ImplementsBlueprintFilter())
+		{
+			if (bHasRejected)
+			{
+				Candidates.Compact(Pass);
+				bHasRejected = false;
+			}
+
+			Filter->FilterCandidatesByArray(SourceActor, Candidates);
+			if (Candidates.IsEmpty())
+			{
+				return;
+			}
+			Pass.Init(1, Candidates.Num());
+		}
+	}
+
+	if (bHasRejected)
+	{
+		Candidates.Compact(Pass);
+	}
+}
+
+void UTargetPointFilterBase::FilterCandidatesByArray(const AActor* SourceActor, FTargetPointCandidateList& Candidates) const
+{
+	TArray<UTargetPointComponent*> TargetPoints(Candidates.Points);
+	if (HasNativePredicate())
+	{
+		// The native predicate already ran, only the Blueprint event is left.
+		CallBlueprintFilter(SourceActor, TargetPoints);
+	}
+	else
+	{
+		FilterTargetPoints(SourceActor, TargetPoints);
+	}
+	Candidates.AssignPoints(TargetPoints);
+}
+
+void UTargetPointFilterBase::CallBlueprintFilter(const AActor* SourceActor, TArray<UTargetPointComponent*>& TargetPoints) const
+{
+	INC_DWORD_STAT(STAT_TargetingSystem_BlueprintFilterInvocations);
 	K2_FilterTargetPoints(SourceActor, TargetPoints);
 }
@@ -3,24 +3,44 @@
 
 #include "Filter/TargetPointFilter_Cone.h"
 
-#include "CrimMathStatics.h"
-#include "TargetPointComponent.h"
+#include "TargetPointKernels.h"
+#include "TargetPointQueryTypes.h"
 
-void UTargetPointFilter_Cone::FilterTargetPoints(const AActor* SourceActor, TArray<UTargetPointComponent*>& TargetPoints) const
+bool UTargetPointFilter_Cone::PassesFilter(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, int32 Index) const
 {
-	Super::FilterTargetPoints(SourceActor, TargetPoints);
+	uint8 bInCone = 0;
+	TargetPointKernels::ConeTestScalar(
+		&Candidates.X[Index],
+		&Candidates.Y[Index],
+		&Candidates.Z[Index],
+		1,
+		Context.SourceLocation,
+		Context.SourceForward,
+		FMath::Cos(FMath::DegreesToRadians(ConeHalfAngle)),
+		&bInCone);
+	return bInCone != 0;
+}
 
-	for (int i = TargetPoints.Num() - 1; i >= 0; i--)
-	{
-		if (UCrimMathStatics::IsInCone(
-				SourceActor->GetActorLocation(),
-				SourceActor->GetActorForwardVector(),
-				ConeHalfAngle,
-				TargetPoints[i]->GetComponentLocation()))
-		{
-			continue;
-		}
+int32 UTargetPointFilter_Cone::EvaluatePredicate(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, TArrayView<uint8> InOutPass) const
+{
+	// Testing every candidate with the vectorized kernel is cheaper than skipping the ones already rejected.
+	TArray<uint8, TInlineAllocator<256>> InCone;
+	InCone.SetNumUninitialized(Candidates.Num());
+	TargetPointKernels::ConeTest(
+		Candidates.X.GetData(),
+		Candidates.Y.GetData(),
+		Candidates.Z.GetData(),
+		Candidates.Num(),
+		Context.SourceLocation,
+		Context.SourceForward,
+		FMath::Cos(FMath::DegreesToRadians(ConeHalfAngle)),
+		InCone.GetData());
 
-		TargetPoints.RemoveAt(i);
+	int32 NumPassing = 0;
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		InOutPass[Index] &= InCone[Index];
+		NumPassing += InOutPass[Index];
 	}
+	return NumPassing;
 }
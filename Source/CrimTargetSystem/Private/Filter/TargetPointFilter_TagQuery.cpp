@@ -0,0 +1,76 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "Filter/TargetPointFilter_TagQuery.h"
+
+#include "TargetPointComponent.h"
+#include "TargetPointQueryTypes.h"
+#include "TargetPointSubsystem.h"
+
+bool UTargetPointFilter_TagQuery::PassesFilter(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, int32 Index) const
+{
+	return MatchesTag(GetCandidateTag(UTargetPointSubsystem::Get(Context.SourceActor), Candidates, Index));
+}
+
+int32 UTargetPointFilter_TagQuery::EvaluatePredicate(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, TArrayView<uint8> InOutPass) const
+{
+	const UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(Context.SourceActor);
+
+	// Candidates share a handful of tags, so the query runs once per entry of the subsystem's tag table rather than
+	// once per candidate. INDEX_NONE means not evaluated yet.
+	TArray<int8, TInlineAllocator<64>> MatchesByTagIndex;
+	if (Subsystem)
+	{
+		MatchesByTagIndex.Init(INDEX_NONE, Subsystem->GetNumTags());
+	}
+
+	int32 NumPassing = 0;
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		if (!InOutPass[Index])
+		{
+			continue;
+		}
+
+		const int32 TagIndex = Candidates.TagIndex[Index];
+		bool bMatches;
+		if (MatchesByTagIndex.IsValidIndex(TagIndex))
+		{
+			if (MatchesByTagIndex[TagIndex] == INDEX_NONE)
+			{
+				MatchesByTagIndex[TagIndex] = MatchesTag(Subsystem->GetTag(TagIndex)) ? 1 : 0;
+			}
+			bMatches = MatchesByTagIndex[TagIndex] != 0;
+		}
+		else
+		{
+			bMatches = MatchesTag(GetCandidateTag(Subsystem, Candidates, Index));
+		}
+
+		InOutPass[Index] = bMatches ? 1 : 0;
+		NumPassing += InOutPass[Index];
+	}
+	return NumPassing;
+}
+
+bool UTargetPointFilter_TagQuery::MatchesTag(const FGameplayTag& Tag) const
+{
+	if (TagQuery.IsEmpty())
+	{
+		return true;
+	}
+	return Tag.IsValid() && TagQuery.Matches(FGameplayTagContainer(Tag));
+}
+
+FGameplayTag UTargetPointFilter_TagQuery::GetCandidateTag(const UTargetPointSubsystem* Subsystem, const FTargetPointCandidateList& Candidates, int32 Index) const
+{
+	const int32 TagIndex = Candidates.TagIndex[Index];
+	if (Subsystem && TagIndex != INDEX_NONE && TagIndex < Subsystem->GetNumTags())
+	{
+		return Subsystem->GetTag(TagIndex);
+	}
+
+	// Candidates added from an array of components don't carry a tag index.
+	const UTargetPointComponent* TargetPoint = Candidates.Points[Index];
+	return IsValid(TargetPoint) ? TargetPoint->GetTargetPointTag() : FGameplayTag();
+}
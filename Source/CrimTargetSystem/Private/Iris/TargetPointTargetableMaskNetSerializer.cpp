@@ -0,0 +1,154 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "Iris/TargetPointTargetableMaskNetSerializer.h"
+
+#include "TargetingSystemTypes.h"
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializationContext.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+
+namespace UE::Net
+{
+
+struct FTargetPointTargetableMaskNetSerializer
+{
+	static constexpr uint32 Version = 0;
+
+	static constexpr uint32 MaxNumBits = FTargetPointTargetableMask::MaxNumBits;
+	static constexpr uint32 MaxNumWords = (MaxNumBits + 31U) / 32U;
+	/** Bits used to send the bit count. */
+	static constexpr uint32 NumBitsBitCount = 11U;
+	static_assert((1U << NumBitsBitCount) > MaxNumBits, "NumBitsBitCount can't hold MaxNumBits.");
+
+	/** Fixed size, so the serializer doesn't need dynamic state. */
+	struct FQuantizedType
+	{
+		uint32 NumBits;
+		uint32 Words[MaxNumWords];
+	};
+
+	typedef FTargetPointTargetableMask SourceType;
+	typedef FQuantizedType QuantizedType;
+	typedef FTargetPointTargetableMaskNetSerializerConfig ConfigType;
+
+	static const ConfigType DefaultConfig;
+
+	static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+	static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+	static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+	static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+	static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+	static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+private:
+	static uint32 GetNumWords(uint32 NumBits) { return FMath::DivideAndRoundUp(NumBits, 32U); }
+
+	class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+	{
+	public:
+		virtual ~FNetSerializerRegistryDelegates();
+
+	private:
+		virtual void OnPreFreezeNetSerializerRegistry() override;
+	};
+
+	static FTargetPointTargetableMaskNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+};
+UE_NET_IMPLEMENT_SERIALIZER(FTargetPointTargetableMaskNetSerializer);
+
+const FTargetPointTargetableMaskNetSerializer::ConfigType FTargetPointTargetableMaskNetSerializer::DefaultConfig;
+FTargetPointTargetableMaskNetSerializer::FNetSerializerRegistryDelegates FTargetPointTargetableMaskNetSerializer::NetSerializerRegistryDelegates;
+
+static const FName PropertyNetSerializerRegistry_NAME_TargetPointTargetableMask("TargetPointTargetableMask");
+UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_TargetPointTargetableMask, FTargetPointTargetableMaskNetSerializer);
+
+void FTargetPointTargetableMaskNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+{
+	const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+	FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+
+	Writer->WriteBits(Value.NumBits, NumBitsBitCount);
+	Writer->WriteBitStream(Value.Words, 0U, Value.NumBits);
+}
+
+void FTargetPointTargetableMaskNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+{
+	QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+	FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+
+	const uint32 NumBits = Reader->ReadBits(NumBitsBitCount);
+	if (NumBits > MaxNumBits)
+	{
+		Context.SetError(GNetError_InvalidValue);
+		return;
+	}
+
+	FMemory::Memzero(Target.Words);
+	Target.NumBits = NumBits;
+	Reader->ReadBitStream(Target.Words, NumBits);
+}
+
+void FTargetPointTargetableMaskNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+{
+	const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+	QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+	const uint32 NumBits = FMath::Min<uint32>(Source.Bits.Num(), MaxNumBits);
+	FMemory::Memzero(Target.Words);
+	Target.NumBits = NumBits;
+	FMemory::Memcpy(Target.Words, Source.Bits.GetData(), GetNumWords(NumBits) * sizeof(uint32));
+
+	// Clear the bits past the end so equal masks compare equal.
+	if (const uint32 NumUsedBits = NumBits % 32U)
+	{
+		Target.Words[NumBits / 32U] &= (1U << NumUsedBits) - 1U;
+	}
+}
+
+void FTargetPointTargetableMaskNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+{
+	const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+	SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+	Target.Bits.Init(false, Source.NumBits);
+	if (Source.NumBits > 0)
+	{
+		FMemory::Memcpy(Target.Bits.GetData(), Source.Words, GetNumWords(Source.NumBits) * sizeof(uint32));
+	}
+}
+
+bool FTargetPointTargetableMaskNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+{
+	if (Args.bStateIsQuantized)
+	{
+		const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+		const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+		return Value0.NumBits == Value1.NumBits
+			&& FMemory::Memcmp(Value0.Words, Value1.Words, GetNumWords(Value0.NumBits) * sizeof(uint32)) == 0;
+	}
+
+	const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+	const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+	return Value0.Bits == Value1.Bits;
+}
+
+bool FTargetPointTargetableMaskNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+{
+	const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+	return Source.Bits.Num() <= static_cast<int32>(MaxNumBits);
+}
+
+FTargetPointTargetableMaskNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+{
+	UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_TargetPointTargetableMask);
+}
+
+void FTargetPointTargetableMaskNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+{
+	UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_TargetPointTargetableMask);
+}
+
+}
@@ -0,0 +1,23 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Iris/Serialization/NetSerializer.h"
+#include "TargetPointTargetableMaskNetSerializer.generated.h"
+
+/**
+ * Iris serializer for FTargetPointTargetableMask. Sends the same packed bit count and bits as its NetSerialize. Only
+ * used when the project replicates with Iris (bUseIris in the Target.cs and net.Iris.UseIrisReplication=1); otherwise
+ * the legacy NetSerialize is used.
+ */
+USTRUCT()
+struct FTargetPointTargetableMaskNetSerializerConfig : public FNetSerializerConfig
+{
+	GENERATED_BODY()
+};
+
+namespace UE::Net
+{
+	UE_NET_DECLARE_SERIALIZER(FTargetPointTargetableMaskNetSerializer, TARGETINGSYSTEM_API);
+}
@@ -0,0 +1,89 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetIndicatorWidget.h"
+
+#include "SceneView.h"
+#include "TargetPointComponent.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+
+
+void UTargetIndicatorWidget::SetTargetPoints(TConstArrayView<UTargetPointComponent*> InTargetPoints)
+{
+	TargetPoints.Reset(InTargetPoints.Num());
+	for (UTargetPointComponent* TargetPoint : InTargetPoints)
+	{
+		TargetPoints.Add(TargetPoint);
+	}
+}
+
+void UTargetIndicatorWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	Canvas = Cast<UCanvasPanel>(GetRootWidget());
+	if (!Canvas && !GetRootWidget())
+	{
+		Canvas = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), FName("IndicatorCanvas"));
+		WidgetTree->RootWidget = Canvas;
+	}
+}
+
+void UTargetIndicatorWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	int32 NumMarkers = 0;
+
+	const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+	FSceneViewProjectionData ProjectionData;
+	if (Canvas && MarkerWidgetClass && !TargetPoints.IsEmpty()
+		&& LocalPlayer && LocalPlayer->ViewportClient && LocalPlayer->ViewportClient->Viewport
+		&& LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+		const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+		const float InvViewportScale = 1.f / FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), UE_KINDA_SMALL_NUMBER);
+
+		for (const TWeakObjectPtr<UTargetPointComponent>& TargetPoint : TargetPoints)
+		{
+			FVector2D ScreenPosition;
+			if (!TargetPoint.IsValid() || !FSceneView::ProjectWorldToScreen(TargetPoint->GetComponentLocation(), ViewRect, ViewProjection, ScreenPosition))
+			{
+				continue;
+			}
+
+			UUserWidget* Marker = GetOrCreateMarker(NumMarkers++);
+			if (UCanvasPanelSlot* MarkerSlot = Cast<UCanvasPanelSlot>(Marker->Slot))
+			{
+				MarkerSlot->SetPosition((ScreenPosition - FVector2D(ViewRect.Min)) * InvViewportScale);
+			}
+			Marker->SetVisibility(ESlateVisibility::HitTestInvisible);
+		}
+	}
+
+	for (int32 Index = NumMarkers; Index < Markers.Num(); Index++)
+	{
+		Markers[Index]->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+UUserWidget* UTargetIndicatorWidget::GetOrCreateMarker(int32 Index)
+{
+	if (Markers.IsValidIndex(Index))
+	{
+		return Markers[Index];
+	}
+
+	UUserWidget* Marker = CreateWidget<UUserWidget>(this, MarkerWidgetClass);
+	UCanvasPanelSlot* MarkerSlot = Canvas->AddChildToCanvas(Marker);
+	MarkerSlot->SetAutoSize(true);
+	MarkerSlot->SetAlignment(MarkerAlignment);
+	Markers.Add(Marker);
+	return Marker;
+}
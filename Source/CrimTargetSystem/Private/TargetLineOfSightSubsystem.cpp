@@ -0,0 +1,176 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetLineOfSightSubsystem.h"
+
+#include "TargetPointComponent.h"
+#include "TargetingSystemSettings.h"
+#include "TargetingSystemStats.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Line Of Sight Tick"), STAT_TargetingSystem_LineOfSightTick, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Traces"), STAT_TargetingSystem_LineOfSightTraces, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Watches"), STAT_TargetingSystem_LineOfSightWatches, STATGROUP_TargetingSystem);
+
+UTargetLineOfSightSubsystem* UTargetLineOfSightSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!IsValid(WorldContextObject))
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UTargetLineOfSightSubsystem>() : nullptr;
+}
+
+void UTargetLineOfSightSubsystem::Deinitialize()
+{
+	Watches.Empty();
+	WatchIndices.Empty();
+	NewWatches.Empty();
+	NextWatchIndex = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UTargetLineOfSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTargetLineOfSightSubsystem, STATGROUP_Tickables);
+}
+
+void UTargetLineOfSightSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_TargetingSystem_LineOfSightTick);
+	SET_DWORD_STAT(STAT_TargetingSystem_LineOfSightWatches, Watches.Num());
+
+	int32 Budget = FMath::Min(GetDefault<UTargetingSystemSettings>()->LineOfSightTracesPerFrame, Watches.Num());
+	int32 NumTraces = 0;
+	if (++TickCount == 0)
+	{
+		TickCount++;
+	}
+
+	// Watches that have never been traced go first so newly locked targets get a result right away.
+	while (Budget > 0 && !NewWatches.IsEmpty())
+	{
+		const FWatchKey Key = NewWatches.Pop(EAllowShrinking::No);
+		const int32* Index = WatchIndices.Find(Key);
+		if (Index && Watches[*Index].TracedTick != TickCount)
+		{
+			TraceWatch(Watches[*Index]);
+			Budget--;
+			NumTraces++;
+		}
+	}
+
+	// Spend the rest of the budget refreshing the oldest results, skipping the watches traced above.
+	for (int32 NumVisited = 0; Budget > 0 && NumVisited < Watches.Num(); NumVisited++)
+	{
+		if (!Watches.IsValidIndex(NextWatchIndex))
+		{
+			NextWatchIndex = 0;
+		}
+		FWatch& Watch = Watches[NextWatchIndex++];
+		if (Watch.TracedTick != TickCount)
+		{
+			TraceWatch(Watch);
+			Budget--;
+			NumTraces++;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_TargetingSystem_LineOfSightTraces, NumTraces);
+}
+
+void UTargetLineOfSightSubsystem::AddWatch(AActor* Source, UTargetPointComponent* TargetPoint)
+{
+	if (!IsValid(Source) || !IsValid(TargetPoint))
+	{
+		return;
+	}
+
+	const FWatchKey Key(Source, TargetPoint);
+	if (const int32* Index = WatchIndices.Find(Key))
+	{
+		Watches[*Index].RefCount++;
+		return;
+	}
+
+	FWatch& Watch = Watches.AddDefaulted_GetRef();
+	Watch.Key = Key;
+	Watch.Source = Source;
+	Watch.TargetPoint = TargetPoint;
+	Watch.RefCount = 1;
+	WatchIndices.Add(Key, Watches.Num() - 1);
+	NewWatches.Add(Key);
+}
+
+void UTargetLineOfSightSubsystem::RemoveWatch(const AActor* Source, const UTargetPointComponent* TargetPoint)
+{
+	const FWatchKey Key(Source, TargetPoint);
+	const int32* IndexPtr = WatchIndices.Find(Key);
+	if (!IndexPtr)
+	{
+		return;
+	}
+
+	const int32 Index = *IndexPtr;
+	if (--Watches[Index].RefCount > 0)
+	{
+		return;
+	}
+
+	WatchIndices.Remove(Key);
+	Watches.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Watches.IsValidIndex(Index))
+	{
+		// The last watch was swapped into the removed slot.
+		WatchIndices.Add(Watches[Index].Key, Index);
+	}
+}
+
+bool UTargetLineOfSightSubsystem::GetLineOfSight(const AActor* Source, const UTargetPointComponent* TargetPoint, bool& bOutVisible) const
+{
+	const int32* Index = WatchIndices.Find(FWatchKey(Source, TargetPoint));
+	if (!Index || !Watches[*Index].bHasResult)
+	{
+		return false;
+	}
+
+	bOutVisible = Watches[*Index].bVisible;
+	return true;
+}
+
+bool UTargetLineOfSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTargetLineOfSightSubsystem::TraceWatch(FWatch& Watch) const
+{
+	Watch.TracedTick = TickCount;
+
+	const AActor* Source = Watch.Source.Get();
+	const UTargetPointComponent* TargetPoint = Watch.TargetPoint.Get();
+	if (!Source || !TargetPoint)
+	{
+		Watch.bHasResult = true;
+		Watch.bVisible = false;
+		return;
+	}
+
+	FHitResult HitResult;
+	FCollisionQueryParams Params = FCollisionQueryParams(FName("LineTraceSingle"));
+	Params.AddIgnoredActor(Source);
+
+	Watch.bVisible = !GetWorld()->LineTraceSingleByChannel(
+		HitResult,
+		Source->GetActorLocation(),
+		TargetPoint->GetComponentLocation(),
+		ECC_Visibility,
+		Params
+	);
+	Watch.bHasResult = true;
+}
@@ -3,6 +3,9 @@
 
 #include "TargetPointComponent.h"
 
+#include "TargetPointManagerComponent.h"
+#include "TargetPointSubsystem.h"
+
 
 UTargetPointComponent::UTargetPointComponent()
 {
@@ -15,10 +18,81 @@ UTargetPointComponent::UTargetPointComponent()
 	SphereRadius = 0.f;
 }
 
+void UTargetPointComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(this))
+	{
+		Subsystem->RegisterTargetPoint(this);
+	}
+
+	AddToOwnerManager();
+}
+
+void UTargetPointComponent::OnUnregister()
+{
+	if (UTargetPointManagerComponent* TargetPointManager = Manager.Get())
+	{
+		TargetPointManager->RemoveTargetPoint(this);
+	}
+
+	if (UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(this))
+	{
+		Subsystem->UnregisterTargetPoint(this);
+	}
+
+	Super::OnUnregister();
+}
+
+void UTargetPointComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	if (RegistryIndex != INDEX_NONE)
+	{
+		if (UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(this))
+		{
+			Subsystem->UpdateTargetPointLocation(this);
+		}
+	}
+}
+
 void UTargetPointComponent::SetIsTargetable(const bool bEnabled)
 {
 	bTargetable = bEnabled;
+
+	if (RegistryIndex != INDEX_NONE)
+	{
+		if (UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(this))
+		{
+			Subsystem->UpdateTargetPointFlags(this);
+		}
+	}
 }
 
+void UTargetPointComponent::AddToOwnerManager()
+{
+	// Managers add the TargetPoints registered before BeginPlay themselves.
+	const AActor* Owner = GetOwner();
+	if (!IsValid(Owner) || Manager.IsValid())
+	{
+		return;
+	}
 
+	UTargetPointManagerComponent* TargetPointManager = Owner->FindComponentByClass<UTargetPointManagerComponent>();
+	if (!IsValid(TargetPointManager) || !TargetPointManager->HasBegunPlay())
+	{
+		return;
+	}
 
+	if (Owner->HasAuthority())
+	{
+		TargetPointManager->AddTargetPoint(this);
+	}
+	else
+	{
+		// Clients only manage the layout TargetPoints, which get their slot back.
+		TargetPointManager->RestoreLayoutItem(this);
+	}
+}
@@ -0,0 +1,283 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetPointKernels.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+
+static TAutoConsoleVariable<bool> CVarTargetingSystemVectorizedKernels(
+	TEXT("TargetingSystem.VectorizedKernels"),
+	true,
+	TEXT("When true, targeting queries use the vectorized kernels. False uses the scalar reference kernels."));
+
+namespace TargetPointKernels
+{
+	int32 FindNearest(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, float& OutDistanceSquared)
+	{
+		if (CVarTargetingSystemVectorizedKernels.GetValueOnAnyThread())
+		{
+			return FindNearestVectorized(X, Y, Z, Num, Origin, OutDistanceSquared);
+		}
+		return FindNearestScalar(X, Y, Z, Num, Origin, OutDistanceSquared);
+	}
+
+	int32 FindNearestScalar(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, float& OutDistanceSquared)
+	{
+		int32 NearestIndex = INDEX_NONE;
+		OutDistanceSquared = TNumericLimits<float>::Max();
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const float DX = X[Index] - Origin.X;
+			const float DY = Y[Index] - Origin.Y;
+			const float DZ = Z[Index] - Origin.Z;
+			const float DistanceSquared = DX * DX + DY * DY + DZ * DZ;
+			if (DistanceSquared < OutDistanceSquared)
+			{
+				OutDistanceSquared = DistanceSquared;
+				NearestIndex = Index;
+			}
+		}
+		return NearestIndex;
+	}
+
+	int32 FindNearestVectorized(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, float& OutDistanceSquared)
+	{
+		const int32 NumVectorized = Num & ~3;
+
+		const VectorRegister4Float OriginX = VectorSetFloat1(Origin.X);
+		const VectorRegister4Float OriginY = VectorSetFloat1(Origin.Y);
+		const VectorRegister4Float OriginZ = VectorSetFloat1(Origin.Z);
+		const VectorRegister4Float Four = VectorSetFloat1(4.f);
+
+		// Each lane tracks its own best distance and index. Indices are stored as floats, which is exact well past
+		// any realistic number of TargetPoints.
+		VectorRegister4Float BestDistance = VectorSetFloat1(TNumericLimits<float>::Max());
+		VectorRegister4Float BestIndex = VectorSetFloat1(-1.f);
+		VectorRegister4Float LaneIndex = MakeVectorRegisterFloat(0.f, 1.f, 2.f, 3.f);
+
+		for (int32 Index = 0; Index < NumVectorized; Index += 4)
+		{
+			const VectorRegister4Float DX = VectorSubtract(VectorLoad(X + Index), OriginX);
+			const VectorRegister4Float DY = VectorSubtract(VectorLoad(Y + Index), OriginY);
+			const VectorRegister4Float DZ = VectorSubtract(VectorLoad(Z + Index), OriginZ);
+			const VectorRegister4Float DistanceSquared = VectorMultiplyAdd(DZ, DZ, VectorMultiplyAdd(DY, DY, VectorMultiply(DX, DX)));
+
+			const VectorRegister4Float Closer = VectorCompareLT(DistanceSquared, BestDistance);
+			BestDistance = VectorSelect(Closer, DistanceSquared, BestDistance);
+			BestIndex = VectorSelect(Closer, LaneIndex, BestIndex);
+			LaneIndex = VectorAdd(LaneIndex, Four);
+		}
+
+		alignas(16) float LaneDistances[4];
+		alignas(16) float LaneIndices[4];
+		VectorStoreAligned(BestDistance, LaneDistances);
+		VectorStoreAligned(BestIndex, LaneIndices);
+
+		int32 NearestIndex = INDEX_NONE;
+		OutDistanceSquared = TNumericLimits<float>::Max();
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const int32 Index = static_cast<int32>(LaneIndices[Lane]);
+			if (Index == INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (LaneDistances[Lane] < OutDistanceSquared ||
+				(LaneDistances[Lane] == OutDistanceSquared && Index < NearestIndex))
+			{
+				OutDistanceSquared = LaneDistances[Lane];
+				NearestIndex = Index;
+			}
+		}
+
+		// Remainder that doesn't fill a full register. These all come after the vectorized indices, so a strict
+		// comparison keeps ties on the lowest index.
+		for (int32 Index = NumVectorized; Index < Num; Index++)
+		{
+			const float DX = X[Index] - Origin.X;
+			const float DY = Y[Index] - Origin.Y;
+			const float DZ = Z[Index] - Origin.Z;
+			const float DistanceSquared = DX * DX + DY * DY + DZ * DZ;
+			if (DistanceSquared < OutDistanceSquared)
+			{
+				OutDistanceSquared = DistanceSquared;
+				NearestIndex = Index;
+			}
+		}
+
+		return NearestIndex;
+	}
+
+	void ConeTest(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle, uint8* OutInCone)
+	{
+		if (CVarTargetingSystemVectorizedKernels.GetValueOnAnyThread())
+		{
+			ConeTestVectorized(X, Y, Z, Num, Origin, Direction, CosHalfAngle, OutInCone);
+		}
+		else
+		{
+			ConeTestScalar(X, Y, Z, Num, Origin, Direction, CosHalfAngle, OutInCone);
+		}
+	}
+
+	/**
+	 * A point is in the cone when Dot(Offset, Direction) >= |Offset| * CosHalfAngle. Both sides are squared to avoid
+	 * the square root, which means the sign of the dot product has to be checked separately.
+	 */
+	static uint8 IsInConeScalar(float DX, float DY, float DZ, const FVector3f& Direction, float CosHalfAngle, float CosHalfAngleSquared)
+	{
+		const float Dot = DX * Direction.X + DY * Direction.Y + DZ * Direction.Z;
+		const float Threshold = (DX * DX + DY * DY + DZ * DZ) * CosHalfAngleSquared;
+		if (CosHalfAngle >= 0.f)
+		{
+			return Dot >= 0.f && Dot * Dot >= Threshold;
+		}
+		return Dot >= 0.f || Dot * Dot <= Threshold;
+	}
+
+	void ConeTestScalar(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle, uint8* OutInCone)
+	{
+		const float CosHalfAngleSquared = CosHalfAngle * CosHalfAngle;
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			OutInCone[Index] = IsInConeScalar(X[Index] - Origin.X, Y[Index] - Origin.Y, Z[Index] - Origin.Z, Direction, CosHalfAngle, CosHalfAngleSquared);
+		}
+	}
+
+	void ConeTestVectorized(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle, uint8* OutInCone)
+	{
+		const int32 NumVectorized = Num & ~3;
+		const float CosHalfAngleSquared = CosHalfAngle * CosHalfAngle;
+		const bool bNarrowCone = CosHalfAngle >= 0.f;
+
+		const VectorRegister4Float OriginX = VectorSetFloat1(Origin.X);
+		const VectorRegister4Float OriginY = VectorSetFloat1(Origin.Y);
+		const VectorRegister4Float OriginZ = VectorSetFloat1(Origin.Z);
+		const VectorRegister4Float DirectionX = VectorSetFloat1(Direction.X);
+		const VectorRegister4Float DirectionY = VectorSetFloat1(Direction.Y);
+		const VectorRegister4Float DirectionZ = VectorSetFloat1(Direction.Z);
+		const VectorRegister4Float CosSquared = VectorSetFloat1(CosHalfAngleSquared);
+		const VectorRegister4Float Zero = VectorZeroFloat();
+
+		for (int32 Index = 0; Index < NumVectorized; Index += 4)
+		{
+			const VectorRegister4Float DX = VectorSubtract(VectorLoad(X + Index), OriginX);
+			const VectorRegister4Float DY = VectorSubtract(VectorLoad(Y + Index), OriginY);
+			const VectorRegister4Float DZ = VectorSubtract(VectorLoad(Z + Index), OriginZ);
+
+			const VectorRegister4Float Dot = VectorMultiplyAdd(DZ, DirectionZ, VectorMultiplyAdd(DY, DirectionY, VectorMultiply(DX, DirectionX)));
+			const VectorRegister4Float LengthSquared = VectorMultiplyAdd(DZ, DZ, VectorMultiplyAdd(DY, DY, VectorMultiply(DX, DX)));
+			const VectorRegister4Float Threshold = VectorMultiply(LengthSquared, CosSquared);
+			const VectorRegister4Float DotSquared = VectorMultiply(Dot, Dot);
+			const VectorRegister4Float InFront = VectorCompareGE(Dot, Zero);
+
+			const VectorRegister4Float InCone = bNarrowCone
+				? VectorBitwiseAnd(InFront, VectorCompareGE(DotSquared, Threshold))
+				: VectorBitwiseOr(InFront, VectorCompareLE(DotSquared, Threshold));
+
+			const uint32 Mask = VectorMaskBits(InCone);
+			OutInCone[Index + 0] = (Mask >> 0) & 1;
+			OutInCone[Index + 1] = (Mask >> 1) & 1;
+			OutInCone[Index + 2] = (Mask >> 2) & 1;
+			OutInCone[Index + 3] = (Mask >> 3) & 1;
+		}
+
+		for (int32 Index = NumVectorized; Index < Num; Index++)
+		{
+			OutInCone[Index] = IsInConeScalar(X[Index] - Origin.X, Y[Index] - Origin.Y, Z[Index] - Origin.Z, Direction, CosHalfAngle, CosHalfAngleSquared);
+		}
+	}
+
+	int32 FindNextAround(const float* X, const float* Y, int32 Num, const FVector2f& Origin, const FVector2f& Reference, bool bSearchLeft)
+	{
+		// Cycling right looks for the smallest positive angle, falling back to the most negative one. Cycling left
+		// looks for the largest negative angle, falling back to the most positive one.
+		float RightComparison = bSearchLeft ? 0.f : 2.f;
+		float LeftComparison = bSearchLeft ? -2.f : 0.f;
+		int32 RightIndex = INDEX_NONE;
+		int32 LeftIndex = INDEX_NONE;
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const float DX = X[Index] - Origin.X;
+			const float DY = Y[Index] - Origin.Y;
+			const float Angle = PseudoAngle(Reference.X * DY - Reference.Y * DX, Reference.X * DX + Reference.Y * DY);
+
+			if (!bSearchLeft)
+			{
+				if (Angle > 0.f && Angle < RightComparison)
+				{
+					RightComparison = Angle;
+					RightIndex = Index;
+				}
+				else if (Angle < 0.f && Angle < LeftComparison)
+				{
+					LeftComparison = Angle;
+					LeftIndex = Index;
+				}
+			}
+			else
+			{
+				if (Angle > 0.f && Angle > RightComparison)
+				{
+					RightComparison = Angle;
+					RightIndex = Index;
+				}
+				else if (Angle < 0.f && Angle > LeftComparison)
+				{
+					LeftComparison = Angle;
+					LeftIndex = Index;
+				}
+			}
+		}
+
+		if (!bSearchLeft)
+		{
+			return RightIndex != INDEX_NONE ? RightIndex : LeftIndex;
+		}
+		return LeftIndex != INDEX_NONE ? LeftIndex : RightIndex;
+	}
+
+	int32 FindNearestInDirection(const float* X, const float* Y, const float* Z, int32 Num, const FViewBasis& View, const FVector2f& From, const FVector2f& Direction, float CosHalfAngle)
+	{
+		const float DirectionSizeSquared = Direction.SizeSquared();
+		if (DirectionSizeSquared <= UE_KINDA_SMALL_NUMBER)
+		{
+			return INDEX_NONE;
+		}
+
+		// Same squared cone test as IsInConeScalar, in 2D and with the direction's length folded into the threshold.
+		const float ThresholdScale = FMath::Square(FMath::Max(CosHalfAngle, 0.f)) * DirectionSizeSquared;
+
+		int32 NearestIndex = INDEX_NONE;
+		float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			FVector2f Screen;
+			if (!View.ToScreen(FVector3f(X[Index], Y[Index], Z[Index]), Screen))
+			{
+				continue;
+			}
+
+			const FVector2f Offset = Screen - From;
+			const float Dot = Offset | Direction;
+			const float DistanceSquared = Offset.SizeSquared();
+			if (Dot <= 0.f || Dot * Dot < DistanceSquared * ThresholdScale)
+			{
+				continue;
+			}
+
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				NearestIndex = Index;
+			}
+		}
+
+		return NearestIndex;
+	}
+}
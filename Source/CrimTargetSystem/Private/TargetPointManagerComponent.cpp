@@ -4,6 +4,9 @@
 #include "TargetPointManagerComponent.h"
 
 #include "TargetPointComponent.h"
+#include "TargetingSystemLogChannels.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
 #include "Net/UnrealNetwork.h"
 
 
@@ -18,7 +21,23 @@ void UTargetPointManagerComponent::GetLifetimeReplicatedProps(TArray<class FLife
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UTargetPointManagerComponent, TargetPointList);
+	DOREPLIFETIME_CONDITION(UTargetPointManagerComponent, TargetPointList, COND_Custom);
+	DOREPLIFETIME_CONDITION_NOTIFY(UTargetPointManagerComponent, TargetableMask, COND_Custom, REPNOTIFY_OnChanged);
+}
+
+void UTargetPointManagerComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UTargetPointManagerComponent, TargetPointList, !bCompactReplication);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UTargetPointManagerComponent, TargetableMask, bCompactReplication);
+}
+
+void UTargetPointManagerComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	TargetPointList.Owner = this;
 }
 
 void UTargetPointManagerComponent::BeginPlay()
@@ -38,17 +57,13 @@ void UTargetPointManagerComponent::SetTargetPointEnabled(UTargetPointComponent*
 	{
 		return;
 	}
-
-	for (auto& Item : TargetPointList.Items)
+	if (TargetPoint->Manager != this || !ensure(TargetPointList.Items.IsValidIndex(TargetPoint->ManagerItemIndex)))
 	{
-		if (Item.TargetPointComponent == TargetPoint)
-		{
-			Item.bCanBeTargeted = bEnabled;
-			Item.TargetPointComponent->SetIsTargetable(bEnabled);
-			TargetPointList.MarkItemDirty(Item);
-			return;
-		}
+		return;
 	}
+
+	check(TargetPointList.Items[TargetPoint->ManagerItemIndex].TargetPointComponent == TargetPoint);
+	SetItemTargetable(TargetPoint->ManagerItemIndex, bEnabled);
 }
 
 void UTargetPointManagerComponent::SetTargetPointEnabledByTag(const FGameplayTag& Type, bool bEnabled)
@@ -58,19 +73,39 @@ void UTargetPointManagerComponent::SetTargetPointEnabledByTag(const FGameplayTag
 		return;
 	}
 
-	for (auto& Item : TargetPointList.Items)
+	for (auto It = TagToItemIndices.CreateConstKeyIterator(Type); It; ++It)
 	{
-		if (Item.TargetPointTag.MatchesTag(Type))
-		{
-			Item.bCanBeTargeted = bEnabled;
-			Item.TargetPointComponent->SetIsTargetable(bEnabled);
-			TargetPointList.MarkItemDirty(Item);
-		}
+		SetItemTargetable(It.Value(), bEnabled);
+	}
+}
+
+void UTargetPointManagerComponent::SetItemTargetable(int32 Index, bool bEnabled)
+{
+	FTargetPointItem& Item = TargetPointList.Items[Index];
+	if (Item.bCanBeTargeted == bEnabled)
+	{
+		return;
+	}
+
+	Item.bCanBeTargeted = bEnabled;
+	if (!bCompactReplication)
+	{
+		TargetPointList.MarkItemDirty(Item);
 	}
+	else if (Index < NumLayoutItems)
+	{
+		TargetableMask.Bits[Index] = bEnabled;
+	}
+	ApplyTargetability(Item);
 }
 
 void UTargetPointManagerComponent::InitializeTargetPoints()
 {
+	if (bCompactReplication)
+	{
+		InitializeLayout();
+	}
+
 	if (!GetOwner()->HasAuthority())
 	{
 		return;
@@ -78,12 +113,235 @@ void UTargetPointManagerComponent::InitializeTargetPoints()
 	
 	TArray<UTargetPointComponent*> TargetPointComponents;
 	GetOwner()->GetComponents(UTargetPointComponent::StaticClass(), TargetPointComponents);
-	for (const auto& Item : TargetPointComponents)
+	for (UTargetPointComponent* TargetPoint : TargetPointComponents)
+	{
+		AddTargetPoint(TargetPoint);
+	}
+}
+
+void UTargetPointManagerComponent::AddTargetPoint(UTargetPointComponent* TargetPoint)
+{
+	if (!IsValid(TargetPoint))
+	{
+		return;
+	}
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+	if (TargetPoint->Manager.IsValid())
+	{
+		UE_CLOG(TargetPoint->Manager != this, LogTargetingSystem, Warning, TEXT("%s is already managed by %s."),
+			*GetNameSafe(TargetPoint), *GetNameSafe(TargetPoint->Manager.Get()));
+		return;
+	}
+
+	if (!RestoreLayoutItem(TargetPoint))
+	{
+		AddItem(TargetPoint);
+	}
+}
+
+int32 UTargetPointManagerComponent::AddItem(UTargetPointComponent* TargetPoint)
+{
+	const int32 Index = TargetPointList.Items.AddDefaulted();
+	FTargetPointItem& NewItem = TargetPointList.Items[Index];
+	NewItem.bCanBeTargeted = TargetPoint->GetIsTargetable();
+	NewItem.TargetPointTag = TargetPoint->GetTargetPointTag();
+	NewItem.TargetPointComponent = TargetPoint;
+	if (!bCompactReplication)
 	{
-		FTargetPointItem& NewItem = TargetPointList.Items.AddDefaulted_GetRef();
-		NewItem.bCanBeTargeted = Item->GetIsTargetable();
-		NewItem.TargetPointTag = Item->GetTargetPointTag();
-		NewItem.TargetPointComponent = Item;
 		TargetPointList.MarkItemDirty(NewItem);
 	}
+	IndexItemTags(Index);
+
+	TargetPoint->Manager = this;
+	TargetPoint->ManagerItemIndex = Index;
+	return Index;
+}
+
+void UTargetPointManagerComponent::InitializeLayout()
+{
+	TArray<UTargetPointComponent*> TargetPointComponents;
+	GetOwner()->GetComponents(UTargetPointComponent::StaticClass(), TargetPointComponents);
+	TargetPointComponents.RemoveAll([](const UTargetPointComponent* TargetPoint)
+	{
+		return !TargetPoint->IsNameStableForNetworking();
+	});
+	Algo::SortBy(TargetPointComponents, &UTargetPointComponent::GetFName, FNameLexicalLess());
+
+	LayoutNames.Reset(TargetPointComponents.Num());
+	for (UTargetPointComponent* TargetPoint : TargetPointComponents)
+	{
+		LayoutNames.Add(TargetPoint->GetFName());
+		if (TargetPoint->Manager.IsValid())
+		{
+			// Managed by another manager of the owner. Keep an empty slot so the layout still matches.
+			TargetPointList.Items.AddDefaulted();
+		}
+		else
+		{
+			AddItem(TargetPoint);
+		}
+	}
+	NumLayoutItems = TargetPointList.Items.Num();
+
+	if (GetOwner()->HasAuthority())
+	{
+		TargetableMask.Bits.Init(false, NumLayoutItems);
+		for (int32 Index = 0; Index < NumLayoutItems; Index++)
+		{
+			TargetableMask.Bits[Index] = TargetPointList.Items[Index].bCanBeTargeted;
+		}
+	}
+	else
+	{
+		// The mask may have been received before BeginPlay.
+		ApplyTargetableMask();
+	}
+}
+
+bool UTargetPointManagerComponent::RestoreLayoutItem(UTargetPointComponent* TargetPoint)
+{
+	if (NumLayoutItems == 0 || TargetPoint->GetOwner() != GetOwner() || !TargetPoint->IsNameStableForNetworking())
+	{
+		return false;
+	}
+
+	const int32 Index = Algo::BinarySearch(LayoutNames, TargetPoint->GetFName(), FNameLexicalLess());
+	if (Index == INDEX_NONE || TargetPointList.Items[Index].TargetPointComponent)
+	{
+		return false;
+	}
+
+	FTargetPointItem& Item = TargetPointList.Items[Index];
+	Item.TargetPointTag = TargetPoint->GetTargetPointTag();
+	Item.TargetPointComponent = TargetPoint;
+	IndexItemTags(Index);
+
+	TargetPoint->Manager = this;
+	TargetPoint->ManagerItemIndex = Index;
+
+	if (GetOwner()->HasAuthority())
+	{
+		Item.bCanBeTargeted = TargetPoint->GetIsTargetable();
+		TargetableMask.Bits[Index] = Item.bCanBeTargeted;
+	}
+	else
+	{
+		// The slot kept the targetability received from the server.
+		ApplyTargetability(Item);
+	}
+	return true;
+}
+
+void UTargetPointManagerComponent::OnRep_TargetableMask()
+{
+	ApplyTargetableMask();
+}
+
+void UTargetPointManagerComponent::ApplyTargetableMask()
+{
+	if (NumLayoutItems == 0 || TargetableMask.Bits.IsEmpty())
+	{
+		return;
+	}
+
+	UE_CLOG(TargetableMask.Bits.Num() != NumLayoutItems, LogTargetingSystem, Warning,
+		TEXT("%s: the replicated layout has %d TargetPoints, the local one %d. Check that the TargetPoints have the same names on the server and client."),
+		*GetPathNameSafe(this), TargetableMask.Bits.Num(), NumLayoutItems);
+
+	const int32 NumItems = FMath::Min(NumLayoutItems, TargetableMask.Bits.Num());
+	for (int32 Index = 0; Index < NumItems; Index++)
+	{
+		FTargetPointItem& Item = TargetPointList.Items[Index];
+		Item.bCanBeTargeted = TargetableMask.Bits[Index];
+		ApplyTargetability(Item);
+	}
+}
+
+void UTargetPointManagerComponent::RemoveTargetPoint(UTargetPointComponent* TargetPoint)
+{
+	if (!TargetPoint || TargetPoint->Manager != this)
+	{
+		return;
+	}
+
+	const int32 Index = TargetPoint->ManagerItemIndex;
+	TargetPoint->Manager.Reset();
+	TargetPoint->ManagerItemIndex = INDEX_NONE;
+	if (!ensure(TargetPointList.Items.IsValidIndex(Index)))
+	{
+		return;
+	}
+
+	UnindexItemTags(Index);
+	if (Index < NumLayoutItems)
+	{
+		// The layout has to match the clients', keep the slot.
+		TargetPointList.Items[Index].TargetPointComponent = nullptr;
+		return;
+	}
+
+	// Swap the last Item into the hole so every other handle stays valid, then fix up the moved Item's handle.
+	const int32 LastIndex = TargetPointList.Items.Num() - 1;
+	if (Index != LastIndex)
+	{
+		UnindexItemTags(LastIndex);
+	}
+
+	TargetPointList.Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (!bCompactReplication)
+	{
+		TargetPointList.MarkArrayDirty();
+	}
+
+	if (Index != LastIndex)
+	{
+		IndexItemTags(Index);
+		if (UTargetPointComponent* MovedTargetPoint = TargetPointList.Items[Index].TargetPointComponent)
+		{
+			MovedTargetPoint->ManagerItemIndex = Index;
+		}
+	}
+}
+
+void UTargetPointManagerComponent::IndexItemTags(int32 Index)
+{
+	const FGameplayTag& Tag = TargetPointList.Items[Index].TargetPointTag;
+	if (!Tag.IsValid())
+	{
+		return;
+	}
+
+	for (const FGameplayTag& ParentTag : Tag.GetGameplayTagParents())
+	{
+		TagToItemIndices.Add(ParentTag, Index);
+	}
+}
+
+void UTargetPointManagerComponent::UnindexItemTags(int32 Index)
+{
+	const FGameplayTag& Tag = TargetPointList.Items[Index].TargetPointTag;
+	if (!Tag.IsValid())
+	{
+		return;
+	}
+
+	for (const FGameplayTag& ParentTag : Tag.GetGameplayTagParents())
+	{
+		TagToItemIndices.Remove(ParentTag, Index);
+	}
+}
+
+void UTargetPointManagerComponent::ApplyTargetability(const FTargetPointItem& Item)
+{
+	UTargetPointComponent* TargetPoint = Item.TargetPointComponent;
+	if (!IsValid(TargetPoint) || TargetPoint->GetIsTargetable() == Item.bCanBeTargeted)
+	{
+		return;
+	}
+
+	TargetPoint->SetIsTargetable(Item.bCanBeTargeted);
+	OnTargetabilityChangedDelegate.Broadcast(TargetPoint, Item.bCanBeTargeted);
 }
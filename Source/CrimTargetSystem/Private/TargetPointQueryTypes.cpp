@@ -0,0 +1,109 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetPointQueryTypes.h"
+
+#include "TargetPointComponent.h"
+
+
+void FTargetPointCandidateList::Compact(TConstArrayView<uint8> Keep)
+{
+	check(Keep.Num() == Num());
+
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < Keep.Num(); ReadIndex++)
+	{
+		if (!Keep[ReadIndex])
+		{
+			continue;
+		}
+
+		if (WriteIndex != ReadIndex)
+		{
+			Points[WriteIndex] = Points[ReadIndex];
+			X[WriteIndex] = X[ReadIndex];
+			Y[WriteIndex] = Y[ReadIndex];
+			Z[WriteIndex] = Z[ReadIndex];
+			TagIndex[WriteIndex] = TagIndex[ReadIndex];
+		}
+		WriteIndex++;
+	}
+
+	Points.SetNum(WriteIndex, EAllowShrinking::No);
+	X.SetNum(WriteIndex, EAllowShrinking::No);
+	Y.SetNum(WriteIndex, EAllowShrinking::No);
+	Z.SetNum(WriteIndex, EAllowShrinking::No);
+	TagIndex.SetNum(WriteIndex, EAllowShrinking::No);
+}
+
+void FTargetPointCandidateList::AssignPoints(TConstArrayView<UTargetPointComponent*> TargetPoints)
+{
+	if (TargetPoints.Num() == Num() && FMemory::Memcmp(TargetPoints.GetData(), Points.GetData(), Num() * sizeof(UTargetPointComponent*)) == 0)
+	{
+		return;
+	}
+
+	// Array based filters usually only remove candidates and keep the order, so walk both lists together and compact
+	// in place when that is all the filter did.
+	TArray<uint8, TInlineAllocator<InlineCapacity>> Keep;
+	Keep.SetNumZeroed(Num());
+	int32 RetainedIndex = 0;
+	for (int32 Index = 0; Index < Num() && RetainedIndex < TargetPoints.Num(); Index++)
+	{
+		if (Points[Index] == TargetPoints[RetainedIndex])
+		{
+			Keep[Index] = 1;
+			RetainedIndex++;
+		}
+	}
+
+	if (RetainedIndex == TargetPoints.Num())
+	{
+		Compact(Keep);
+		return;
+	}
+
+	// The filter reordered or added TargetPoints. Rebuild the list in the filter's order.
+	TMap<UTargetPointComponent*, int32> IndexByPoint;
+	IndexByPoint.Reserve(Num());
+	for (int32 Index = 0; Index < Num(); Index++)
+	{
+		IndexByPoint.Add(Points[Index], Index);
+	}
+
+	FTargetPointCandidateList Assigned;
+	for (UTargetPointComponent* TargetPoint : TargetPoints)
+	{
+		if (const int32* Index = IndexByPoint.Find(TargetPoint))
+		{
+			Assigned.Add(TargetPoint, X[*Index], Y[*Index], Z[*Index], TagIndex[*Index]);
+		}
+		else
+		{
+			Assigned.AppendPoints(MakeArrayView(&TargetPoint, 1));
+		}
+	}
+	*this = MoveTemp(Assigned);
+}
+
+void FTargetPointCandidateList::AppendPoints(TConstArrayView<UTargetPointComponent*> TargetPoints)
+{
+	for (UTargetPointComponent* TargetPoint : TargetPoints)
+	{
+		if (IsValid(TargetPoint))
+		{
+			const FVector Location = TargetPoint->GetComponentLocation();
+			Add(TargetPoint, Location.X, Location.Y, Location.Z, INDEX_NONE);
+		}
+	}
+}
+
+FTargetPointFilterContext::FTargetPointFilterContext(const AActor* InSourceActor)
+	: SourceActor(InSourceActor)
+{
+	if (IsValid(SourceActor))
+	{
+		SourceLocation = FVector3f(SourceActor->GetActorLocation());
+		SourceForward = FVector3f(SourceActor->GetActorForwardVector());
+	}
+}
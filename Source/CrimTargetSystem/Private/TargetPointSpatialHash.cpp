@@ -0,0 +1,45 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetPointSpatialHash.h"
+
+
+void FTargetPointSpatialHash::Add(int32 Index, const FIntVector& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Index);
+}
+
+void FTargetPointSpatialHash::Remove(int32 Index, const FIntVector& Cell)
+{
+	if (TArray<int32>* Indices = Cells.Find(Cell))
+	{
+		Indices->RemoveSingleSwap(Index, EAllowShrinking::No);
+		if (Indices->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void FTargetPointSpatialHash::Move(int32 Index, const FIntVector& OldCell, const FIntVector& NewCell)
+{
+	if (OldCell == NewCell)
+	{
+		return;
+	}
+
+	Remove(Index, OldCell);
+	Add(Index, NewCell);
+}
+
+void FTargetPointSpatialHash::Reindex(int32 OldIndex, int32 NewIndex, const FIntVector& Cell)
+{
+	if (TArray<int32>* Indices = Cells.Find(Cell))
+	{
+		const int32 Found = Indices->Find(OldIndex);
+		if (Found != INDEX_NONE)
+		{
+			(*Indices)[Found] = NewIndex;
+		}
+	}
+}
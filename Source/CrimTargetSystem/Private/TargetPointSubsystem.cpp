@@ -0,0 +1,213 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetPointSubsystem.h"
+
+#include "TargetPointComponent.h"
+#include "TargetingSystemSettings.h"
+#include "Engine/World.h"
+
+UTargetPointSubsystem* UTargetPointSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!IsValid(WorldContextObject))
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UTargetPointSubsystem>() : nullptr;
+}
+
+void UTargetPointSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UTargetingSystemSettings* Settings = GetDefault<UTargetingSystemSettings>();
+	SpatialHash.SetCellSize(Settings->TargetPointGridCellSize);
+	MoveThresholdSquared = FMath::Square(static_cast<double>(Settings->TargetMoveThreshold));
+}
+
+void UTargetPointSubsystem::Deinitialize()
+{
+	for (UTargetPointComponent* TargetPoint : TargetPoints)
+	{
+		if (TargetPoint)
+		{
+			TargetPoint->RegistryIndex = INDEX_NONE;
+		}
+	}
+	TargetPoints.Empty();
+	TargetPointCells.Empty();
+	MovedFromLocations.Empty();
+	SpatialHash.Reset();
+	Snapshot.Reset();
+	Tags.Empty();
+	TagIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UTargetPointSubsystem::RegisterTargetPoint(UTargetPointComponent* TargetPoint)
+{
+	if (!IsValid(TargetPoint) || TargetPoint->RegistryIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	const FVector Location = TargetPoint->GetComponentLocation();
+	const int32 Index = TargetPoints.Add(TargetPoint);
+	const FIntVector Cell = SpatialHash.GetCell(Location);
+	TargetPointCells.Add(Cell);
+	MovedFromLocations.Add(Location);
+	SpatialHash.Add(Index, Cell);
+	Snapshot.Add(Location, GetTargetPointFlags(TargetPoint), FindOrAddTagIndex(TargetPoint->GetTargetPointTag()));
+	TargetPoint->RegistryIndex = Index;
+	Revision++;
+}
+
+void UTargetPointSubsystem::UnregisterTargetPoint(UTargetPointComponent* TargetPoint)
+{
+	if (!TargetPoint)
+	{
+		return;
+	}
+
+	const int32 Index = TargetPoint->RegistryIndex;
+	if (!TargetPoints.IsValidIndex(Index) || TargetPoints[Index] != TargetPoint)
+	{
+		return;
+	}
+
+	SpatialHash.Remove(Index, TargetPointCells[Index]);
+
+	// The last TargetPoint gets swapped into the removed slot, so its grid entry must follow it.
+	const int32 LastIndex = TargetPoints.Num() - 1;
+	if (Index != LastIndex)
+	{
+		SpatialHash.Reindex(LastIndex, Index, TargetPointCells[LastIndex]);
+	}
+
+	TargetPoints.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TargetPointCells.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MovedFromLocations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Snapshot.RemoveAtSwap(Index);
+	if (TargetPoints.IsValidIndex(Index))
+	{
+		TargetPoints[Index]->RegistryIndex = Index;
+	}
+	TargetPoint->RegistryIndex = INDEX_NONE;
+	Revision++;
+
+	OnTargetPointUnregistered.Broadcast(TargetPoint);
+}
+
+void UTargetPointSubsystem::UpdateTargetPointLocation(UTargetPointComponent* TargetPoint)
+{
+	const int32 Index = TargetPoint->RegistryIndex;
+	if (!TargetPoints.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	const FVector Location = TargetPoint->GetComponentLocation();
+	Snapshot.SetLocation(Index, Location);
+
+	const FIntVector NewCell = SpatialHash.GetCell(Location);
+	FIntVector& OldCell = TargetPointCells[Index];
+	if (NewCell != OldCell)
+	{
+		SpatialHash.Move(Index, OldCell, NewCell);
+		OldCell = NewCell;
+	}
+
+	if (FVector::DistSquared(MovedFromLocations[Index], Location) > MoveThresholdSquared)
+	{
+		MovedFromLocations[Index] = Location;
+		OnTargetPointMoved.Broadcast(TargetPoint);
+	}
+}
+
+void UTargetPointSubsystem::UpdateTargetPointFlags(UTargetPointComponent* TargetPoint)
+{
+	const int32 Index = TargetPoint->RegistryIndex;
+	if (TargetPoints.IsValidIndex(Index))
+	{
+		const ETargetPointFlags NewFlags = GetTargetPointFlags(TargetPoint);
+		if (Snapshot.Flags[Index] != NewFlags)
+		{
+			Snapshot.Flags[Index] = NewFlags;
+			Revision++;
+			OnTargetabilityChanged.Broadcast(TargetPoint);
+		}
+	}
+}
+
+void UTargetPointSubsystem::GetTargetPointsInRange(const FVector& Origin, float Radius, TArray<UTargetPointComponent*>& OutTargetPoints) const
+{
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+
+	SpatialHash.ForEachInRange(Origin, Radius, [&](const int32 Index)
+	{
+		if (FVector::DistSquared(Origin, Snapshot.GetLocation(Index)) <= RadiusSquared)
+		{
+			OutTargetPoints.Add(TargetPoints[Index]);
+		}
+	});
+}
+
+void UTargetPointSubsystem::GatherCandidates(const FVector& Origin, float Radius, ETargetPointFlags RequiredFlags, FTargetPointCandidateList& OutCandidates) const
+{
+	const FVector3f Origin3f(Origin);
+	const float RadiusSquared = FMath::Square(Radius);
+
+	SpatialHash.ForEachInRange(Origin, Radius, [&](const int32 Index)
+	{
+		if (!EnumHasAllFlags(Snapshot.Flags[Index], RequiredFlags))
+		{
+			return;
+		}
+
+		const float X = Snapshot.X[Index];
+		const float Y = Snapshot.Y[Index];
+		const float Z = Snapshot.Z[Index];
+		if (FMath::Square(X - Origin3f.X) + FMath::Square(Y - Origin3f.Y) + FMath::Square(Z - Origin3f.Z) <= RadiusSquared)
+		{
+			OutCandidates.Add(TargetPoints[Index], X, Y, Z, Snapshot.TagIndex[Index]);
+		}
+	});
+}
+
+int32 UTargetPointSubsystem::GetSnapshotIndex(const UTargetPointComponent* TargetPoint) const
+{
+	if (!IsValid(TargetPoint) || !TargetPoints.IsValidIndex(TargetPoint->RegistryIndex) || TargetPoints[TargetPoint->RegistryIndex] != TargetPoint)
+	{
+		return INDEX_NONE;
+	}
+	return TargetPoint->RegistryIndex;
+}
+
+int32 UTargetPointSubsystem::FindTagIndex(const FGameplayTag& Tag) const
+{
+	const int32* TagIndex = TagIndices.Find(Tag);
+	return TagIndex ? *TagIndex : INDEX_NONE;
+}
+
+int32 UTargetPointSubsystem::FindOrAddTagIndex(const FGameplayTag& Tag)
+{
+	if (const int32* TagIndex = TagIndices.Find(Tag))
+	{
+		return *TagIndex;
+	}
+	return TagIndices.Add(Tag, Tags.Add(Tag));
+}
+
+ETargetPointFlags UTargetPointSubsystem::GetTargetPointFlags(const UTargetPointComponent* TargetPoint)
+{
+	return TargetPoint->GetIsTargetable() ? ETargetPointFlags::Targetable : ETargetPointFlags::None;
+}
+
+bool UTargetPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Every world that runs gameplay, preview worlds included, queries TargetPoints through the subsystem.
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::GamePreview || WorldType == EWorldType::GameRPC;
+}
@@ -0,0 +1,490 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetValidationSubsystem.h"
+
+#include "TargetPointComponent.h"
+#include "TargetPointSubsystem.h"
+#include "TargetingSystemComponent.h"
+#include "TargetingSystemLogChannels.h"
+#include "TargetingSystemSettings.h"
+#include "TargetingSystemStats.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Validation Tick"), STAT_TargetingSystem_ValidationTick, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Validations"), STAT_TargetingSystem_Validations, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Validations Deferred"), STAT_TargetingSystem_ValidationsDeferred, STATGROUP_TargetingSystem);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Target Validation Budget Overrun (us)"), STAT_TargetingSystem_ValidationOverrun, STATGROUP_TargetingSystem);
+DECLARE_CYCLE_STAT(TEXT("Target Request Validation"), STAT_TargetingSystem_TargetRequestValidation, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Requests Validated"), STAT_TargetingSystem_TargetRequestsValidated, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Requests Rejected"), STAT_TargetingSystem_TargetRequestsRejected, STATGROUP_TargetingSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Target Request Traces"), STAT_TargetingSystem_TargetRequestTraces, STATGROUP_TargetingSystem);
+
+UTargetValidationSubsystem* UTargetValidationSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!IsValid(WorldContextObject))
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UTargetValidationSubsystem>() : nullptr;
+}
+
+void UTargetValidationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	MoveThresholdSquared = FMath::Square(static_cast<double>(GetDefault<UTargetingSystemSettings>()->TargetMoveThreshold));
+
+	if (UTargetPointSubsystem* TargetPointSubsystem = Collection.InitializeDependency<UTargetPointSubsystem>())
+	{
+		TargetPointSubsystem->OnTargetabilityChanged.AddUObject(this, &UTargetValidationSubsystem::HandleTargetabilityChanged);
+		TargetPointSubsystem->OnTargetPointUnregistered.AddUObject(this, &UTargetValidationSubsystem::HandleTargetPointUnregistered);
+		TargetPointSubsystem->OnTargetPointMoved.AddUObject(this, &UTargetValidationSubsystem::HandleTargetPointMoved);
+	}
+}
+
+void UTargetValidationSubsystem::Deinitialize()
+{
+	if (UTargetPointSubsystem* TargetPointSubsystem = UTargetPointSubsystem::Get(this))
+	{
+		TargetPointSubsystem->OnTargetabilityChanged.RemoveAll(this);
+		TargetPointSubsystem->OnTargetPointUnregistered.RemoveAll(this);
+		TargetPointSubsystem->OnTargetPointMoved.RemoveAll(this);
+	}
+
+	Entries.Empty();
+	Watchers.Empty();
+	TargetRequests.Empty();
+	NextEntryIndex = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UTargetValidationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTargetValidationSubsystem, STATGROUP_Tickables);
+}
+
+void UTargetValidationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_TargetingSystem_ValidationTick);
+
+	ProcessTargetRequests();
+
+	for (int32 Index = Entries.Num() - 1; Index >= 0; Index--)
+	{
+		if (!Entries[Index].Component.IsValid())
+		{
+			RemoveWatches(Entries[Index]);
+			Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	if (Entries.IsEmpty())
+	{
+		return;
+	}
+
+	// Range checks don't trace, so they run as soon as either end moved instead of waiting on the poll. Checking can
+	// unregister the component, so go backwards.
+	for (int32 Index = Entries.Num() - 1; Index >= 0; Index--)
+	{
+		if (Entries.IsValidIndex(Index))
+		{
+			CheckRange(Entries[Index]);
+		}
+	}
+
+	GatherViewLocations();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double BudgetMicroseconds = GetDefault<UTargetingSystemSettings>()->ValidationBudgetMicroseconds;
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	int32 NumValidated = 0;
+	int32 NumDeferred = 0;
+	int32 FirstDeferredIndex = INDEX_NONE;
+
+	const int32 NumEntries = Entries.Num();
+	NextEntryIndex = Entries.IsValidIndex(NextEntryIndex) ? NextEntryIndex : 0;
+
+	for (int32 Step = 0; Step < NumEntries; Step++)
+	{
+		const int32 Index = (NextEntryIndex + Step) % NumEntries;
+		FEntry& Entry = Entries[Index];
+		const ESignificance Significance = GetSignificance(Entry.Component.Get());
+
+		if (Entry.NextValidationTime > Now)
+		{
+			continue;
+		}
+
+		// Locally controlled players are never deferred, they are what the player sees.
+		if (Significance == ESignificance::LocalPlayer)
+		{
+			Validate(Entry, Significance, Now);
+			NumValidated++;
+			continue;
+		}
+
+		const double ElapsedMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+		if (ElapsedMicroseconds >= BudgetMicroseconds)
+		{
+			if (FirstDeferredIndex == INDEX_NONE)
+			{
+				FirstDeferredIndex = Index;
+			}
+			NumDeferred++;
+			continue;
+		}
+
+		Validate(Entry, Significance, Now);
+		NumValidated++;
+	}
+
+	// Continue with whatever didn't fit in the budget next frame.
+	NextEntryIndex = FirstDeferredIndex != INDEX_NONE ? FirstDeferredIndex : 0;
+
+	const double TotalMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+	INC_DWORD_STAT_BY(STAT_TargetingSystem_Validations, NumValidated);
+	INC_DWORD_STAT_BY(STAT_TargetingSystem_ValidationsDeferred, NumDeferred);
+	INC_FLOAT_STAT_BY(STAT_TargetingSystem_ValidationOverrun, FMath::Max(TotalMicroseconds - BudgetMicroseconds, 0.0));
+}
+
+void UTargetValidationSubsystem::RegisterComponent(UTargetingSystemComponent* Component)
+{
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	FEntry* Entry = Entries.FindByPredicate([Component](const FEntry& Other) { return Other.Component == Component; });
+	if (!Entry)
+	{
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->Component = Component;
+		Entry->NextValidationTime = GetWorld()->GetTimeSeconds() + Component->CheckFrequency;
+	}
+
+	RemoveWatches(*Entry);
+	AddWatches(*Entry);
+
+	// The targets changed, so check them on the next tick regardless of movement.
+	Component->bTargetRangeCheckPending = true;
+}
+
+void UTargetValidationSubsystem::UnregisterComponent(UTargetingSystemComponent* Component)
+{
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		if (Entries[Index].Component == Component)
+		{
+			RemoveWatches(Entries[Index]);
+			Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			return;
+		}
+	}
+}
+
+void UTargetValidationSubsystem::QueueTargetRequest(UTargetingSystemComponent* Component, const FTargetingStateRequest& State)
+{
+	FTargetRequest* Request = TargetRequests.FindByPredicate([Component](const FTargetRequest& Other)
+	{
+		return Other.Component == Component;
+	});
+	if (!Request)
+	{
+		Request = &TargetRequests.AddDefaulted_GetRef();
+		Request->Component = Component;
+	}
+	else if (!UTargetingSystemComponent::IsNewerTargetPredictionKey(State.PredictionKey, Request->PredictionKey))
+	{
+		return;
+	}
+
+	// Replacing the request drops a trace that is still in flight, its result no longer matches a request.
+	Request->TargetPoint = State.TargetPoint;
+	Request->PredictionKey = State.PredictionKey;
+	Request->bCameraLocked = State.bCameraLocked;
+	Request->bClearTarget = State.TargetPoint == nullptr;
+	Request->TraceHandle = FTraceHandle();
+}
+
+void UTargetValidationSubsystem::ProcessTargetRequests()
+{
+	if (TargetRequests.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TargetingSystem_TargetRequestValidation);
+
+	int32 NumTraces = 0;
+	for (int32 Index = TargetRequests.Num() - 1; Index >= 0; Index--)
+	{
+		FTargetRequest& Request = TargetRequests[Index];
+		if (Request.TraceHandle.IsValid())
+		{
+			continue;
+		}
+
+		// Clearing needs no checks, and the current target is already validated continuously, e.g. when only the camera
+		// lock changed.
+		const UTargetingSystemComponent* Component = Request.Component.Get();
+		const bool bSkipChecks = Component && (Request.bClearTarget || Request.TargetPoint == Component->TargetedPoint);
+		if (!Component || bSkipChecks || !IsTargetRequestInRange(Request))
+		{
+			ResolveTargetRequest(Request, bSkipChecks);
+			TargetRequests.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// The traces of every request this frame run together on the async trace pass and complete next frame.
+		Request.TraceHandle = Component->AsyncTraceLineOfSight(Request.TargetPoint->GetComponentLocation(),
+			FTraceDelegate::CreateUObject(this, &UTargetValidationSubsystem::OnTargetRequestTraceComplete));
+		NumTraces++;
+	}
+
+	INC_DWORD_STAT_BY(STAT_TargetingSystem_TargetRequestTraces, NumTraces);
+}
+
+bool UTargetValidationSubsystem::IsTargetRequestInRange(const FTargetRequest& Request) const
+{
+	const UTargetingSystemComponent* Component = Request.Component.Get();
+	const UTargetPointSubsystem* TargetPointSubsystem = UTargetPointSubsystem::Get(this);
+	if (!Component || !IsValid(Component->OwnerPawn) || !TargetPointSubsystem)
+	{
+		return false;
+	}
+
+	const int32 SnapshotIndex = TargetPointSubsystem->GetSnapshotIndex(Request.TargetPoint.Get());
+	if (SnapshotIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FTargetPointSnapshot& Snapshot = TargetPointSubsystem->GetSnapshot();
+	if (!EnumHasAllFlags(Snapshot.Flags[SnapshotIndex], ETargetPointFlags::Targetable))
+	{
+		return false;
+	}
+
+	const double DistanceSquared = FVector::DistSquared(Component->OwnerPawn->GetActorLocation(), Snapshot.GetLocation(SnapshotIndex));
+	return DistanceSquared <= FMath::Square(static_cast<double>(Component->MaxTargetingRange));
+}
+
+void UTargetValidationSubsystem::OnTargetRequestTraceComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const int32 Index = TargetRequests.IndexOfByPredicate([&TraceHandle](const FTargetRequest& Request)
+	{
+		return Request.TraceHandle == TraceHandle;
+	});
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FTargetRequest& Request = TargetRequests[Index];
+	ResolveTargetRequest(Request, Request.TargetPoint.IsValid() && !FHitResult::GetFirstBlockingHit(TraceDatum.OutHits));
+	TargetRequests.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UTargetValidationSubsystem::ResolveTargetRequest(const FTargetRequest& Request, bool bAccepted) const
+{
+	UTargetingSystemComponent* Component = Request.Component.Get();
+	if (!Component)
+	{
+		return;
+	}
+
+	FTargetingStateRequest State;
+	State.TargetPoint = Request.TargetPoint.Get();
+	State.bCameraLocked = Request.bCameraLocked;
+	State.PredictionKey = Request.PredictionKey;
+
+	// The component rejects accepted requests it can no longer apply, e.g. when the TargetPoint stopped being targetable.
+	INC_DWORD_STAT(STAT_TargetingSystem_TargetRequestsValidated);
+	if (!Component->ResolveTargetingStateRequest(State, bAccepted))
+	{
+		INC_DWORD_STAT(STAT_TargetingSystem_TargetRequestsRejected);
+		UE_LOG(LogTargetingSystem, Verbose, TEXT("%s: rejected the request to target %s."),
+			*GetPathNameSafe(Component), *GetPathNameSafe(Request.TargetPoint.Get()));
+	}
+}
+
+bool UTargetValidationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTargetValidationSubsystem::GatherViewLocations()
+{
+	ViewLocations.Reset();
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+UTargetValidationSubsystem::ESignificance UTargetValidationSubsystem::GetSignificance(const UTargetingSystemComponent* Component) const
+{
+	const APawn* OwnerPawn = Component->OwnerPawn;
+	if (!IsValid(OwnerPawn))
+	{
+		return ESignificance::Dormant;
+	}
+
+	if (OwnerPawn->IsLocallyControlled() && OwnerPawn->IsPlayerControlled())
+	{
+		return ESignificance::LocalPlayer;
+	}
+
+	const UTargetingSystemSettings* Settings = GetDefault<UTargetingSystemSettings>();
+	const FVector Location = OwnerPawn->GetActorLocation();
+	double ClosestDistanceSquared = TNumericLimits<double>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(Location, ViewLocation));
+	}
+
+	if (ClosestDistanceSquared <= FMath::Square(Settings->ValidationNearDistance))
+	{
+		return ESignificance::Near;
+	}
+	if (ClosestDistanceSquared <= FMath::Square(Settings->ValidationFarDistance))
+	{
+		return ESignificance::Far;
+	}
+	return ESignificance::Dormant;
+}
+
+double UTargetValidationSubsystem::GetValidationInterval(ESignificance Significance, const UTargetingSystemComponent* Component) const
+{
+	const UTargetingSystemSettings* Settings = GetDefault<UTargetingSystemSettings>();
+	switch (Significance)
+	{
+	case ESignificance::LocalPlayer:
+	case ESignificance::Near:
+		return Component->CheckFrequency;
+	case ESignificance::Far:
+		return FMath::Max<double>(Settings->FarValidationInterval, Component->CheckFrequency);
+	case ESignificance::Dormant:
+	default:
+		return FMath::Max<double>(Settings->DormantValidationInterval, Component->CheckFrequency);
+	}
+}
+
+void UTargetValidationSubsystem::Validate(FEntry& Entry, ESignificance Significance, double Now) const
+{
+	UTargetingSystemComponent* Component = Entry.Component.Get();
+	Entry.NextValidationTime = Now + GetValidationInterval(Significance, Component);
+	Component->CheckTargetLineOfSight();
+}
+
+void UTargetValidationSubsystem::CheckRange(FEntry& Entry) const
+{
+	UTargetingSystemComponent* Component = Entry.Component.Get();
+	if (!Component || !IsValid(Component->OwnerPawn))
+	{
+		return;
+	}
+
+	const FVector OwnerLocation = Component->OwnerPawn->GetActorLocation();
+	if (!Component->bTargetRangeCheckPending && FVector::DistSquared(Entry.OwnerLocation, OwnerLocation) <= MoveThresholdSquared)
+	{
+		return;
+	}
+
+	Entry.OwnerLocation = OwnerLocation;
+	Component->bTargetRangeCheckPending = false;
+	Component->CheckTargetRange();
+}
+
+void UTargetValidationSubsystem::AddWatches(FEntry& Entry)
+{
+	UTargetingSystemComponent* Component = Entry.Component.Get();
+	if (IsValid(Component->TargetedPoint))
+	{
+		Entry.WatchedPoints.Add(Component->TargetedPoint.Get());
+	}
+	for (const FLockedTargetItem& Item : Component->LockedTargets.GetAllItems())
+	{
+		if (IsValid(Item.TargetPoint))
+		{
+			Entry.WatchedPoints.AddUnique(Item.TargetPoint.Get());
+		}
+	}
+
+	for (const TObjectKey<UTargetPointComponent>& TargetPoint : Entry.WatchedPoints)
+	{
+		Watchers.FindOrAdd(TargetPoint).Add(Entry.Component);
+	}
+}
+
+void UTargetValidationSubsystem::RemoveWatches(FEntry& Entry)
+{
+	for (const TObjectKey<UTargetPointComponent>& TargetPoint : Entry.WatchedPoints)
+	{
+		if (auto* PointWatchers = Watchers.Find(TargetPoint))
+		{
+			PointWatchers->RemoveSingleSwap(Entry.Component, EAllowShrinking::No);
+			if (PointWatchers->IsEmpty())
+			{
+				Watchers.Remove(TargetPoint);
+			}
+		}
+	}
+	Entry.WatchedPoints.Reset();
+}
+
+void UTargetValidationSubsystem::HandleTargetabilityChanged(UTargetPointComponent* TargetPoint)
+{
+	for (UTargetingSystemComponent* Component : GetWatchers(TargetPoint))
+	{
+		Component->HandleWatchedTargetabilityChanged(TargetPoint);
+	}
+}
+
+void UTargetValidationSubsystem::HandleTargetPointUnregistered(UTargetPointComponent* TargetPoint)
+{
+	for (UTargetingSystemComponent* Component : GetWatchers(TargetPoint))
+	{
+		Component->HandleWatchedTargetPointRemoved(TargetPoint);
+	}
+}
+
+void UTargetValidationSubsystem::HandleTargetPointMoved(UTargetPointComponent* TargetPoint)
+{
+	// Several moves in one frame only need one check, so leave it to the next tick.
+	for (UTargetingSystemComponent* Component : GetWatchers(TargetPoint))
+	{
+		Component->bTargetRangeCheckPending = true;
+	}
+}
+
+TArray<UTargetingSystemComponent*, TInlineAllocator<4>> UTargetValidationSubsystem::GetWatchers(const UTargetPointComponent* TargetPoint) const
+{
+	TArray<UTargetingSystemComponent*, TInlineAllocator<4>> Result;
+	if (const auto* PointWatchers = Watchers.Find(TargetPoint))
+	{
+		for (const TWeakObjectPtr<UTargetingSystemComponent>& Component : *PointWatchers)
+		{
+			if (Component.IsValid())
+			{
+				Result.Add(Component.Get());
+			}
+		}
+	}
+	return Result;
+}
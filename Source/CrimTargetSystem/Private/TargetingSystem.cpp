@@ -2,17 +2,32 @@
 
 #include "TargetingSystem.h"
 
+#include "TargetingSystemSettings.h"
+#include "Engine/World.h"
+
 #define LOCTEXT_NAMESPACE "FTargetingSystemModule"
 
 void FTargetingSystemModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Stream the default target widget in ahead of time, so the first lock on doesn't have to wait for it. Dedicated
+	// servers never create widgets.
+	PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddLambda([](UWorld* World, const UWorld::InitializationValues)
+	{
+		if (World && World->IsGameWorld() && !IsRunningDedicatedServer() && World->GetNetMode() != NM_DedicatedServer)
+		{
+			UTargetingSystemSettings::LoadDefaultTargetWidgetClass();
+		}
+	});
 }
 
 void FTargetingSystemModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+	UTargetingSystemSettings::ReleaseDefaultTargetWidgetClass();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,12 +3,18 @@
 
 #include "TargetingSystemComponent.h"
 
+#include "TargetIndicatorWidget.h"
+#include "TargetLineOfSightSubsystem.h"
 #include "TargetPointComponent.h"
+#include "TargetPointKernels.h"
+#include "TargetPointQueryTypes.h"
+#include "TargetPointSubsystem.h"
+#include "TargetValidationSubsystem.h"
 #include "TargetingSystemLogChannels.h"
 #include "TargetingSystemSettings.h"
+#include "Algo/StableSort.h"
 #include "Camera/CameraComponent.h"
 #include "Components/WidgetComponent.h"
-#include "Engine/OverlapResult.h"
 #include "Filter/TargetPointFilterBase.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Net/UnrealNetwork.h"
@@ -26,7 +32,12 @@ void UTargetingSystemComponent::BeginPlay()
 
 	if (!TargetWidgetClass)
 	{
-		TargetWidgetClass = UTargetingSystemSettings::GetDefaultTargetWidgetClass();	
+		TargetWidgetClass = UTargetingSystemSettings::GetDefaultTargetWidgetClass();
+		if (!TargetWidgetClass)
+		{
+			UTargetingSystemSettings::OnDefaultTargetWidgetClassLoaded.AddUObject(this, &UTargetingSystemComponent::HandleDefaultTargetWidgetClassLoaded);
+			UTargetingSystemSettings::LoadDefaultTargetWidgetClass();
+		}
 	}
 
 	OwnerPawn = Cast<APawn>(GetOwner());
@@ -49,6 +60,39 @@ void UTargetingSystemComponent::BeginPlay()
 	CacheIsNetSimulated();
 }
 
+void UTargetingSystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Stop the shared line of sight watch and validation, TargetedPoint is no longer relevant once we leave play.
+	if (LineOfSightWatchedPoint)
+	{
+		if (UTargetLineOfSightSubsystem* LineOfSight = UTargetLineOfSightSubsystem::Get(this))
+		{
+			LineOfSight->RemoveWatch(OwnerPawn, LineOfSightWatchedPoint);
+		}
+		LineOfSightWatchedPoint = nullptr;
+	}
+
+	if (UTargetValidationSubsystem* Validation = UTargetValidationSubsystem::Get(this))
+	{
+		Validation->UnregisterComponent(this);
+	}
+
+	if (IsValid(TargetWidgetComponent))
+	{
+		TargetWidgetComponent->DestroyComponent();
+		TargetWidgetComponent = nullptr;
+	}
+
+	if (CandidateIndicator)
+	{
+		CandidateIndicator->RemoveFromParent();
+		CandidateIndicator = nullptr;
+	}
+	UTargetingSystemSettings::OnDefaultTargetWidgetClassLoaded.RemoveAll(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UTargetingSystemComponent::PreNetReceive()
 {
 	Super::PreNetReceive();
@@ -60,6 +104,7 @@ void UTargetingSystemComponent::OnRegister()
 {
 	Super::OnRegister();
 	CacheIsNetSimulated();
+	LockedTargets.Owner = this;
 }
 
 bool UTargetingSystemComponent::HasAuthority() const
@@ -71,8 +116,12 @@ void UTargetingSystemComponent::GetLifetimeReplicatedProps(TArray<class FLifetim
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, TargetedPoint, COND_None, REPNOTIFY_OnChanged);
-	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, bCameraLocked, COND_None, REPNOTIFY_OnChanged);
+	// Always notify: an accepted prediction already holds the server's value, and the client still has to confirm it.
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, TargetedPoint, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, AcknowledgedTargetPredictionKey, COND_OwnerOnly, REPNOTIFY_Always);
+	// Only the owning client rotates its camera.
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, bCameraLocked, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME(ThisClass, LockedTargets);
 }
 
 void UTargetingSystemComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -83,207 +132,265 @@ void UTargetingSystemComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 	{
 		SetControlRotation(TargetedPoint, DeltaTime);
 	}
+
+	if (CandidateIndicatorClass)
+	{
+		UpdateCandidateIndicator();
+	}
+
+	UpdateTargetingStateRequest();
 }
 
-void UTargetingSystemComponent::SetTarget(UTargetPointComponent* NewTargetPoint)
+bool UTargetingSystemComponent::SetTarget(UTargetPointComponent* NewTargetPoint)
 {
 	if (TargetedPoint == NewTargetPoint)
 	{
-		return;
+		return true;
 	}
 
 	if (!IsValid(NewTargetPoint))
 	{
 		ClearTarget();
-		return;
+		return NewTargetPoint == nullptr && TargetedPoint == nullptr;
 	}
 
-	if (!NewTargetPoint || !NewTargetPoint->GetIsTargetable())
+	if (!NewTargetPoint->GetIsTargetable())
 	{
-		return;
+		return false;
 	}
 	
-	TargetedPoint = NewTargetPoint;
-	OnTargetedPointSet();
-	OnTargetedPointUpdatedDelegate.Broadcast(TargetedPoint);
+	if (!PrepareTargetingStateChange())
+	{
+		return false;
+	}
+	ApplyTargetedPoint(NewTargetPoint);
+	return true;
+}
 
-	if (!HasAuthority())
+UTargetPointComponent* UTargetingSystemComponent::FindNearestTarget(const TArray<UTargetPointFilterBase*>& Filters) const
+{
+	const FTargetPointCandidateList& Candidates = GetCandidates(Filters);
+
+	if (Candidates.IsEmpty())
 	{
-		Server_SetTarget(NewTargetPoint);
+		return nullptr;
 	}
-	else
+
+	const int32 BestIndex = SelectBestCandidate(Candidates);
+	return Candidates.Points.IsValidIndex(BestIndex) ? Candidates.Points[BestIndex] : nullptr;
+}
+
+UTargetPointComponent* UTargetingSystemComponent::FindNextTarget(UTargetPointComponent* OriginPoint, const TArray<UTargetPointFilterBase*>& Filters, bool bSearchLeft) const
+{
+	const FTargetPointCandidateList& Candidates = GetCandidates(Filters);
+	UTargetPointComponent* CurrentTarget = OriginPoint ? OriginPoint : static_cast<UTargetPointComponent*>(TargetedPoint);
+
+	if (!IsValid(CurrentTarget))
 	{
-		OnRep_TargetedPoint();
+		const int32 BestIndex = SelectBestCandidate(Candidates);
+		return Candidates.Points.IsValidIndex(BestIndex) ? Candidates.Points[BestIndex] : nullptr;
 	}
+
+	const FVector ReferenceLocation = CameraComponent->GetComponentLocation();
+	const FVector ReferenceTarget = CurrentTarget->GetComponentLocation();
+	const int32 NextIndex = TargetPointKernels::FindNextAround(
+		Candidates.X.GetData(),
+		Candidates.Y.GetData(),
+		Candidates.Num(),
+		FVector2f(ReferenceLocation.X, ReferenceLocation.Y),
+		FVector2f(ReferenceTarget.X - ReferenceLocation.X, ReferenceTarget.Y - ReferenceLocation.Y),
+		bSearchLeft);
+
+	return NextIndex != INDEX_NONE ? Candidates.Points[NextIndex] : CurrentTarget;
 }
 
-UTargetPointComponent* UTargetingSystemComponent::FindNearestTarget(const TArray<UTargetPointFilterBase*>& Filters) const
+UTargetPointComponent* UTargetingSystemComponent::FindTargetInDirection(UTargetPointComponent* OriginPoint, const TArray<UTargetPointFilterBase*>& Filters, FVector2D Direction) const
 {
-	TArray<UTargetPointComponent*> TargetablePoints = GetTargetablePoints(Filters);
+	const FTargetPointCandidateList& Candidates = GetCandidates(Filters);
+	UTargetPointComponent* CurrentTarget = OriginPoint ? OriginPoint : static_cast<UTargetPointComponent*>(TargetedPoint);
 
-	if (TargetablePoints.IsEmpty())
+	if (!IsValid(CurrentTarget))
 	{
-		return nullptr;
+		const int32 BestIndex = SelectBestCandidate(Candidates);
+		return Candidates.Points.IsValidIndex(BestIndex) ? Candidates.Points[BestIndex] : nullptr;
+	}
+
+	TargetPointKernels::FViewBasis View;
+	View.Origin = FVector3f(CameraComponent->GetComponentLocation());
+	View.Forward = FVector3f(CameraComponent->GetForwardVector());
+	View.Right = FVector3f(CameraComponent->GetRightVector());
+	View.Up = FVector3f(CameraComponent->GetUpVector());
+
+	FVector2f From;
+	if (!View.ToScreen(FVector3f(CurrentTarget->GetComponentLocation()), From))
+	{
+		// The current target is behind the camera, search from the centre of the screen instead.
+		From = FVector2f::ZeroVector;
 	}
 
-	UTargetPointComponent* NearestTarget = nullptr;
-	float ClosestDistance = TNumericLimits<float>::Max();
-	FVector Origin = OwnerPawn->GetActorLocation();
+	const int32 NextIndex = TargetPointKernels::FindNearestInDirection(
+		Candidates.X.GetData(),
+		Candidates.Y.GetData(),
+		Candidates.Z.GetData(),
+		Candidates.Num(),
+		View,
+		From,
+		FVector2f(Direction),
+		FMath::Cos(FMath::DegreesToRadians(DirectionalSwitchHalfAngle)));
+
+	return NextIndex != INDEX_NONE ? Candidates.Points[NextIndex] : CurrentTarget;
+}
+
+void UTargetingSystemComponent::ClearTarget()
+{
+	if (TargetedPoint == nullptr)
+	{
+		return;
+	}
 	
-	for (UTargetPointComponent* Target : TargetablePoints)
+	if (!PrepareTargetingStateChange())
 	{
-		if (IsValid(Target))
-		{
-			const float Distance = (Origin - Target->GetComponentLocation()).Size();
-			if (Distance < ClosestDistance)
-			{
-				ClosestDistance = Distance;
-				NearestTarget = Target;
-			}
-		}
+		return;
 	}
-	return NearestTarget;
+	ApplyTargetedPoint(nullptr);
 }
 
-UTargetPointComponent* UTargetingSystemComponent::FindNextTarget(UTargetPointComponent* OriginPoint, const TArray<UTargetPointFilterBase*>& Filters, bool bSearchLeft) const
+AActor* UTargetingSystemComponent::GetTargetedActor() const
+{
+	return TargetedPoint ? TargetedPoint->GetOwner() : nullptr;
+}
+
+UTargetPointComponent* UTargetingSystemComponent::GetTargetedPoint() const
 {
-	TArray<UTargetPointComponent*> TargetablePoints = GetTargetablePoints(Filters);
-	UTargetPointComponent* NewTarget = OriginPoint ? OriginPoint : static_cast<UTargetPointComponent*>(TargetedPoint);
+	return TargetedPoint;
+}
 
-	if (IsValid(NewTarget))
+void UTargetingSystemComponent::SetLockedTargets(const TArray<UTargetPointComponent*>& TargetPoints)
+{
+	if (!HasAuthority())
 	{
-		const FVector ReferenceLocation = CameraComponent->GetComponentLocation();
-		const FVector ReferenceActor = NewTarget->GetComponentLocation();
-		FVector2D ReferenceVector = {ReferenceActor.X - ReferenceLocation.X , ReferenceActor.Y - ReferenceLocation.Y};
-		ReferenceVector.Normalize();
-
-		float RightComparison;
-		float LeftComparison;
-		UTargetPointComponent* RightTarget = nullptr;
-		UTargetPointComponent* LeftTarget = nullptr;
+		Server_SetLockedTargets(TargetPoints);
+		return;
+	}
 
-		if(bSearchLeft)
+	TArray<UTargetPointComponent*, TInlineAllocator<8>> NewTargets;
+	for (UTargetPointComponent* TargetPoint : TargetPoints)
+	{
+		if (NewTargets.Num() >= MaxLockedTargets)
 		{
-			// Cycle to the left
-			RightComparison = 0.f;
-			LeftComparison = -180.f;
+			break;
 		}
-		else
+		if (IsLockedTargetValid(TargetPoint))
 		{
-			// Cycle to the right
-			RightComparison = 180.f;
-			LeftComparison = 0.f;
+			NewTargets.AddUnique(TargetPoint);
 		}
+	}
 
-		for (UTargetPointComponent* Target : TargetablePoints)
+	bool bChanged = false;
+	for (int32 Index = LockedTargets.Items.Num() - 1; Index >= 0; Index--)
+	{
+		if (!NewTargets.Contains(LockedTargets.Items[Index].TargetPoint))
 		{
-			if (!IsValid(Target))
-			{
-				continue;
-			}
-			
-			// Gets the rotation from the source actor to the next potential targetable actor.
-			const FVector TargetLocation = Target->GetComponentLocation();
-			FVector2D ComparisonActorVector = {TargetLocation.X - ReferenceLocation.X , TargetLocation.Y - ReferenceLocation.Y};
-			ComparisonActorVector.Normalize();
-
-			const float ZRotation = FMath::RadiansToDegrees(FGenericPlatformMath::Acos(
-				FVector2D::DotProduct(ReferenceVector, ComparisonActorVector))) *
-					FMath::Sign(FVector2D::CrossProduct(ReferenceVector, ComparisonActorVector));
-
-			//Get the target closest to the right and furthest from the left of the original target if we choose targets to the right
-			if (!bSearchLeft)
-			{
-				if (ZRotation > 0 && ZRotation < RightComparison)
-				{
-					RightComparison = ZRotation;
-					RightTarget = Target;
-				}
-				else if (ZRotation < 0 && ZRotation < LeftComparison)
-				{
-					LeftComparison = ZRotation;
-					LeftTarget = Target;
-				}
-			}
-			else
-			{
-				if (ZRotation > 0 && ZRotation > RightComparison)
-				{
-					RightComparison = ZRotation;
-					RightTarget = Target;
-				}
-				else if (ZRotation < 0 && ZRotation > LeftComparison)
-				{
-					LeftComparison = ZRotation;
-					LeftTarget = Target;
-				}
-			}
+			LockedTargets.Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			bChanged = true;
 		}
+	}
+	if (bChanged)
+	{
+		LockedTargets.MarkArrayDirty();
+	}
 
-		if (RightTarget || LeftTarget)
+	// Locks that are already in the right order keep their LockOrder, so only new or reordered locks are sent.
+	int32 PreviousLockOrder = INDEX_NONE;
+	for (UTargetPointComponent* TargetPoint : NewTargets)
+	{
+		FLockedTargetItem* Item = LockedTargets.Items.FindByPredicate([TargetPoint](const FLockedTargetItem& LockedTarget)
 		{
-			// Selects target to the right
-			if (!bSearchLeft)
-			{
-				if (RightTarget)
-				{
-					NewTarget = RightTarget;
-				}
-				else if (LeftTarget)
-				{
-					NewTarget = LeftTarget;
-				}
-			}
-			else
-			{
-				if (LeftTarget)
-				{
-					NewTarget = LeftTarget;
-				}
-				else if (RightTarget)
-				{
-					NewTarget = RightTarget;
-				}
-			}
+			return LockedTarget.TargetPoint == TargetPoint;
+		});
+
+		if (Item && Item->LockOrder > PreviousLockOrder)
+		{
+			PreviousLockOrder = Item->LockOrder;
+			continue;
+		}
+
+		if (!Item)
+		{
+			Item = &LockedTargets.Items.AddDefaulted_GetRef();
+			Item->TargetPoint = TargetPoint;
 		}
+		Item->LockOrder = ++PreviousLockOrder;
+		LockedTargets.MarkItemDirty(*Item);
+		bChanged = true;
 	}
-	else
+
+	if (bChanged)
 	{
-		NewTarget = FindNearestTarget(Filters);
+		OnRep_LockedTargets();
 	}
-	
-	return NewTarget;
 }
 
-void UTargetingSystemComponent::ClearTarget()
+void UTargetingSystemComponent::AddLockedTarget(UTargetPointComponent* TargetPoint)
 {
-	if (TargetedPoint == nullptr)
+	if (!HasAuthority())
 	{
+		Server_AddLockedTarget(TargetPoint);
 		return;
 	}
-	
-	TargetedPoint = nullptr;
-	OnClearTarget();
-	OnTargetedPointUpdatedDelegate.Broadcast(TargetedPoint);
 
+	TArray<UTargetPointComponent*> TargetPoints = GetLockedTargets();
+	TargetPoints.Add(TargetPoint);
+	SetLockedTargets(TargetPoints);
+}
+
+void UTargetingSystemComponent::RemoveLockedTarget(UTargetPointComponent* TargetPoint)
+{
 	if (!HasAuthority())
 	{
-		Server_ClearTarget();
-	}
-	else
-	{
-		OnRep_TargetedPoint();
+		Server_RemoveLockedTarget(TargetPoint);
+		return;
 	}
+
+	TArray<UTargetPointComponent*> TargetPoints = GetLockedTargets();
+	TargetPoints.Remove(TargetPoint);
+	SetLockedTargets(TargetPoints);
 }
 
-AActor* UTargetingSystemComponent::GetTargetedActor() const
+void UTargetingSystemComponent::ClearLockedTargets()
 {
-	return TargetedPoint ? TargetedPoint->GetOwner() : nullptr;
+	SetLockedTargets(TArray<UTargetPointComponent*>());
 }
 
-UTargetPointComponent* UTargetingSystemComponent::GetTargetedPoint() const
+void UTargetingSystemComponent::FillLockedTargets(const TArray<UTargetPointFilterBase*>& Filters)
 {
-	return TargetedPoint;
+	const FTargetPointCandidateList& Candidates = GetCandidates(Filters);
+
+	TArray<float, TInlineAllocator<64>> Scores;
+	Scores.SetNumUninitialized(Candidates.Num());
+	ScoreCandidates(Candidates, Scores);
+
+	TArray<int32, TInlineAllocator<64>> Order;
+	Order.SetNumUninitialized(Candidates.Num());
+	for (int32 Index = 0; Index < Order.Num(); Index++)
+	{
+		Order[Index] = Index;
+	}
+	Algo::StableSortBy(Order, [&Scores](const int32 Index) { return Scores[Index]; });
+
+	TArray<UTargetPointComponent*> TargetPoints;
+	for (int32 Rank = 0; Rank < Order.Num() && TargetPoints.Num() < MaxLockedTargets; Rank++)
+	{
+		TargetPoints.Add(Candidates.Points[Order[Rank]]);
+	}
+	SetLockedTargets(TargetPoints);
+}
+
+TArray<UTargetPointComponent*> UTargetingSystemComponent::GetLockedTargets() const
+{
+	TArray<UTargetPointComponent*> TargetPoints;
+	LockedTargets.GetTargetPoints(TargetPoints);
+	return TargetPoints;
 }
 
 void UTargetingSystemComponent::ToggleCameraLock()
@@ -305,95 +412,276 @@ void UTargetingSystemComponent::SetCameraLock(bool bLock)
 		return;
 	}
 
+	if (!PrepareTargetingStateChange())
+	{
+		return;
+	}
+	ApplyCameraLock(bLock);
+}
+
+void UTargetingSystemComponent::ApplyCameraLock(bool bLock)
+{
 	bCameraLocked = bLock;
 	OnCameraLockSet();
 	OnCameraLockSetDelegate.Broadcast(bCameraLocked);
+}
 
-	if (!HasAuthority())
+bool UTargetingSystemComponent::IsCameraLocked() const
+{
+	return bCameraLocked;
+}
+
+TArray<UTargetPointComponent*> UTargetingSystemComponent::GetTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters) const
+{
+	const FTargetPointCandidateList& Candidates = GetCandidates(Filters);
+	return TArray<UTargetPointComponent*>(Candidates.Points);
+}
+
+void UTargetingSystemComponent::GatherTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters, FTargetPointCandidateList& OutCandidates) const
+{
+	OutCandidates = GetCandidates(Filters);
+}
+
+void UTargetingSystemComponent::InvalidateCandidateCache()
+{
+	for (FCandidateCacheEntry& Entry : CandidateCache)
 	{
-		Server_SetCameraLock(bCameraLocked);
+		Entry.Frame = MAX_uint64;
 	}
-	else
+}
+
+const FTargetPointCandidateList& UTargetingSystemComponent::GetCandidates(const TArray<UTargetPointFilterBase*>& Filters) const
+{
+	const UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(this);
+	const FVector Origin = OwnerPawn->GetActorLocation();
+	const uint32 Revision = Subsystem ? Subsystem->GetRevision() : 0;
+
+	CandidateCacheUses++;
+
+	FCandidateCacheEntry* Evict = &CandidateCache[0];
+	for (FCandidateCacheEntry& Entry : CandidateCache)
+	{
+		if (Entry.Frame == GFrameCounter
+			&& Entry.Origin == Origin
+			&& Entry.Range == MaxTargetingRange
+			&& Entry.Revision == Revision
+			&& Entry.Matches(Filters))
+		{
+			Entry.LastUsed = CandidateCacheUses;
+			return Entry.Candidates;
+		}
+
+		// Entries from an earlier frame can't be hit again, prefer them over the least recently used one.
+		const bool bEntryStale = Entry.Frame != GFrameCounter;
+		const bool bEvictStale = Evict->Frame != GFrameCounter;
+		if (bEntryStale != bEvictStale ? bEntryStale : Entry.LastUsed < Evict->LastUsed)
+		{
+			Evict = &Entry;
+		}
+	}
+
+	Evict->Frame = GFrameCounter;
+	Evict->LastUsed = CandidateCacheUses;
+	Evict->Origin = Origin;
+	Evict->Range = MaxTargetingRange;
+	Evict->Revision = Revision;
+	Evict->Filters.Reset();
+	Evict->Filters.Append(Filters);
+	Evict->Candidates.Reset();
+
+	if (Subsystem)
 	{
-		OnRep_CameraLocked();
+		Subsystem->GatherCandidates(Origin, MaxTargetingRange, ETargetPointFlags::None, Evict->Candidates);
 	}
+
+	UTargetPointFilterBase::ApplyFilters(OwnerPawn, Filters, Evict->Candidates);
+	return Evict->Candidates;
 }
 
-bool UTargetingSystemComponent::IsCameraLocked() const
+void UTargetingSystemComponent::AsyncGetTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters, FTargetingSystemCompTargetPointsDelegate OnComplete) const
 {
-	return bCameraLocked;
+	/** Collects the line of sight results until every trace has come back. */
+	struct FAsyncTargetablePointsQuery
+	{
+		TArray<TWeakObjectPtr<UTargetPointComponent>> Candidates;
+		TArray<bool> InLineOfSight;
+		int32 PendingTraces = 0;
+		FTargetingSystemCompTargetPointsDelegate OnComplete;
+
+		void Complete() const
+		{
+			TArray<UTargetPointComponent*> TargetPoints;
+			TargetPoints.Reserve(Candidates.Num());
+			for (int32 Index = 0; Index < Candidates.Num(); Index++)
+			{
+				if (InLineOfSight[Index] && Candidates[Index].IsValid())
+				{
+					TargetPoints.Add(Candidates[Index].Get());
+				}
+			}
+			OnComplete.ExecuteIfBound(TargetPoints);
+		}
+	};
+
+	const FTargetPointCandidateList& Candidates = GetCandidates(Filters);
+
+	TSharedRef<FAsyncTargetablePointsQuery> Query = MakeShared<FAsyncTargetablePointsQuery>();
+	Query->Candidates.Append(Candidates.Points);
+	Query->InLineOfSight.Init(false, Candidates.Num());
+	Query->PendingTraces = Candidates.Num();
+	Query->OnComplete = MoveTemp(OnComplete);
+
+	if (Candidates.IsEmpty())
+	{
+		// Keep the result arriving next frame, same as when traces are issued.
+		GetWorld()->GetTimerManager().SetTimerForNextTick([Query]()
+		{
+			Query->Complete();
+		});
+		return;
+	}
+
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		const FTraceDelegate OnTraceComplete = FTraceDelegate::CreateLambda([Query, Index](const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+		{
+			Query->InLineOfSight[Index] = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits) == nullptr;
+			if (--Query->PendingTraces == 0)
+			{
+				Query->Complete();
+			}
+		});
+		AsyncTraceLineOfSight(Candidates.GetLocation(Index), OnTraceComplete);
+	}
 }
 
-TArray<UTargetPointComponent*> UTargetingSystemComponent::GetTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters) const
+float UTargetingSystemComponent::GetDistanceToPoint(const UTargetPointComponent* InTargetPoint) const
+{
+	return FMath::Sqrt(GetDistanceSquaredToPoint(InTargetPoint));
+}
+
+float UTargetingSystemComponent::GetDistanceSquaredToPoint(const UTargetPointComponent* InTargetPoint) const
 {
-	TArray<UTargetPointComponent*> TargetablePoints;
+	if (IsValid(InTargetPoint) && IsValid(OwnerPawn))
+	{
+		return FVector::DistSquared(OwnerPawn->GetActorLocation(), InTargetPoint->GetComponentLocation());
+	}
+	return 0.f;
+}
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(SphereOverlapComponenets), false);
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+bool UTargetingSystemComponent::IsWithinTargetingRange(const UTargetPointComponent* InTargetPoint) const
+{
+	return GetDistanceSquaredToPoint(InTargetPoint) <= FMath::Square(MaxTargetingRange);
+}
 
-	TArray<FOverlapResult> Overlaps;
-	GetWorld()->OverlapMultiByObjectType(
-	   Overlaps,
-	   OwnerPawn->GetActorLocation(),
-	   FQuat::Identity,
-	   ObjectParams,
-	   FCollisionShape::MakeSphere(MaxTargetingRange),
-	   Params
-   );
+void UTargetingSystemComponent::ScoreCandidates(const FTargetPointCandidateList& Candidates, TArrayView<float> OutScores) const
+{
+	check(OutScores.Num() == Candidates.Num());
 
-	for (FOverlapResult& Overlap : Overlaps)
+	// Resolve the tag priorities to the tag table indices the candidates carry.
+	TArray<TPair<int32, float>, TInlineAllocator<8>> TagPriorities;
+	if (!ScoreWeights.TagPriority.IsEmpty())
 	{
-		if (Overlap.Component.IsValid())
+		if (const UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(this))
 		{
-			if (UTargetPointComponent* C = Cast<UTargetPointComponent>(Overlap.Component.Get()))
+			for (const TPair<FGameplayTag, float>& Pair : ScoreWeights.TagPriority)
 			{
-				TargetablePoints.Add(C);
+				const int32 TagIndex = Subsystem->FindTagIndex(Pair.Key);
+				if (TagIndex != INDEX_NONE)
+				{
+					TagPriorities.Emplace(TagIndex, Pair.Value);
+				}
 			}
 		}
 	}
 
-	for (const UTargetPointFilterBase* Filter : Filters)
+	const FVector3f Origin(OwnerPawn->GetActorLocation());
+	const FVector3f ViewOrigin(IsValid(CameraComponent) ? CameraComponent->GetComponentLocation() : OwnerPawn->GetActorLocation());
+	const FVector3f ViewDirection(IsValid(CameraComponent) ? CameraComponent->GetForwardVector() : OwnerPawn->GetActorForwardVector());
+	const float DistanceScale = ScoreWeights.Distance / FMath::Max(FMath::Square(MaxTargetingRange), UE_KINDA_SMALL_NUMBER);
+
+	for (int32 Index = 0; Index < Candidates.Num(); Index++)
 	{
-		if (IsValid(Filter))
+		const FVector3f Offset = FVector3f(Candidates.X[Index], Candidates.Y[Index], Candidates.Z[Index]) - Origin;
+		float Score = Offset.SizeSquared() * DistanceScale;
+
+		if (ScoreWeights.ScreenCenterOffset != 0.f)
+		{
+			// Squared cosine of the angle off the view direction, mapped so it increases monotonically from 0 in
+			// front of the camera to 2 behind it.
+			const FVector3f ViewOffset = FVector3f(Candidates.X[Index], Candidates.Y[Index], Candidates.Z[Index]) - ViewOrigin;
+			const float Dot = ViewOffset | ViewDirection;
+			const float LengthSquared = ViewOffset.SizeSquared();
+			const float CosSquared = LengthSquared > UE_KINDA_SMALL_NUMBER ? (Dot * Dot) / LengthSquared : 1.f;
+			Score += ScoreWeights.ScreenCenterOffset * (Dot >= 0.f ? 1.f - CosSquared : 1.f + CosSquared);
+		}
+
+		for (const TPair<int32, float>& TagPriority : TagPriorities)
 		{
-			Filter->FilterTargetPoints(OwnerPawn, TargetablePoints);
+			if (Candidates.TagIndex[Index] == TagPriority.Key)
+			{
+				Score -= TagPriority.Value;
+			}
 		}
+
+		OutScores[Index] = Score;
 	}
-	
-	return TargetablePoints;
 }
 
-float UTargetingSystemComponent::GetDistanceToPoint(const UTargetPointComponent* InTargetPoint) const
+int32 UTargetingSystemComponent::SelectBestCandidate(const FTargetPointCandidateList& Candidates) const
 {
-	if (IsValid(InTargetPoint))
+	if (Candidates.IsEmpty())
 	{
-		return (OwnerPawn->GetActorLocation() - InTargetPoint->GetComponentLocation()).Size();	
+		return INDEX_NONE;
 	}
-	return 0.f;
+
+	// Plain distance scoring is just a nearest point search.
+	if (ScoreWeights.IsDistanceOnly() && ScoreWeights.Distance > 0.f)
+	{
+		float ClosestDistanceSquared;
+		return TargetPointKernels::FindNearest(
+			Candidates.X.GetData(),
+			Candidates.Y.GetData(),
+			Candidates.Z.GetData(),
+			Candidates.Num(),
+			FVector3f(OwnerPawn->GetActorLocation()),
+			ClosestDistanceSquared);
+	}
+
+	TArray<float, TInlineAllocator<64>> Scores;
+	Scores.SetNumUninitialized(Candidates.Num());
+	ScoreCandidates(Candidates, Scores);
+
+	int32 BestIndex = 0;
+	for (int32 Index = 1; Index < Scores.Num(); Index++)
+	{
+		if (Scores[Index] < Scores[BestIndex])
+		{
+			BestIndex = Index;
+		}
+	}
+	return BestIndex;
 }
 
 void UTargetingSystemComponent::OnTargetedPointSet()
 {
 	CreateAndAttachTargetSelectedWidgetComponent(TargetedPoint);
 	TargetedPoint->GetOwner()->OnDestroyed.AddUniqueDynamic(this, &UTargetingSystemComponent::OnTargetPointOwnerDestroyed);
-	
-	GetWorld()->GetTimerManager().SetTimer(
-		CheckTargetPointTimerHandle,
-		this,
-		&UTargetingSystemComponent::CheckTargetPoint,
-		CheckFrequency,
-		true
-	);
+	UpdateLineOfSightWatch();
+	UpdateValidationRegistration();
 }
 
 void UTargetingSystemComponent::OnClearTarget()
 {
-	if (IsValid(TargetWidgetComponent))
+	HideTargetWidgetComponent();
+	UpdateLineOfSightWatch();
+	UpdateValidationRegistration();
+
+	// Not SetCameraLock, clearing the target already sends the unlocked state and rolling back must not send anything.
+	if (bCameraLocked)
 	{
-		TargetWidgetComponent->DestroyComponent();
+		ApplyCameraLock(false);
 	}
-	SetCameraLock(false);
 }
 
 void UTargetingSystemComponent::OnCameraLockSet()
@@ -432,22 +720,148 @@ void UTargetingSystemComponent::CacheIsNetSimulated()
 	bCachedIsNetSimulated = IsNetSimulating();
 }
 
-void UTargetingSystemComponent::CheckTargetPoint()
+void UTargetingSystemComponent::ValidateTargets()
 {
-	if (ShouldBreakTargeting() && !bIsBreakingLineOfSight)
+	// Without locked targets, an unset TargetedPoint still goes through CheckTargetPoint so targeting is broken.
+	if (TargetedPoint || LockedTargets.IsEmpty())
 	{
-		bIsBreakingLineOfSight = true;
-		GetWorld()->GetTimerManager().SetTimer(
-			BreakTargetPointTimerHandle,
-			this,
-			&UTargetingSystemComponent::BreakTargeting,
-			BreakTargetingDelay
-		);
+		CheckTargetPoint();
 	}
-}
 
-bool UTargetingSystemComponent::ShouldBreakTargeting() const
-{
+	if (HasAuthority())
+	{
+		ValidateLockedTargets();
+	}
+}
+
+void UTargetingSystemComponent::UpdateValidationRegistration()
+{
+	// Simulated proxies can't change their target, the server validates it for them.
+	const bool bCanChangeTarget = HasAuthority() || IsPredictingTargetingState();
+	const bool bNeedsValidation = (bCanChangeTarget && IsValid(TargetedPoint)) || (HasAuthority() && !LockedTargets.IsEmpty());
+
+	if (UTargetValidationSubsystem* Validation = UTargetValidationSubsystem::Get(this))
+	{
+		if (bNeedsValidation)
+		{
+			Validation->RegisterComponent(this);
+		}
+		else
+		{
+			Validation->UnregisterComponent(this);
+		}
+	}
+	else if (bNeedsValidation)
+	{
+		if (!GetWorld()->GetTimerManager().IsTimerActive(CheckTargetPointTimerHandle))
+		{
+			GetWorld()->GetTimerManager().SetTimer(
+				CheckTargetPointTimerHandle,
+				this,
+				&UTargetingSystemComponent::ValidateTargets,
+				CheckFrequency,
+				true
+			);
+		}
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().ClearTimer(CheckTargetPointTimerHandle);
+	}
+}
+
+void UTargetingSystemComponent::CheckTargetPoint()
+{
+	if (bIsBreakingLineOfSight)
+	{
+		return;
+	}
+
+	if (ShouldBreakTargetingIgnoringLineOfSight())
+	{
+		StartBreakingTargeting();
+		return;
+	}
+
+	CheckTargetLineOfSight();
+}
+
+void UTargetingSystemComponent::CheckTargetRange()
+{
+	if (IsValid(TargetedPoint) && !bIsBreakingLineOfSight && ShouldBreakTargetingIgnoringLineOfSight())
+	{
+		StartBreakingTargeting();
+	}
+
+	if (HasAuthority())
+	{
+		ValidateLockedTargets();
+	}
+}
+
+void UTargetingSystemComponent::CheckTargetLineOfSight()
+{
+	if (bIsBreakingLineOfSight || !IsValid(TargetedPoint))
+	{
+		return;
+	}
+
+	switch (LineOfSightMode)
+	{
+	case ETargetingLineOfSightMode::Synchronous:
+		if (IsLineOfSightBlocked(TargetedPoint->GetComponentLocation()))
+		{
+			StartBreakingTargeting();
+		}
+		break;
+	case ETargetingLineOfSightMode::Asynchronous:
+		if (!GetWorld()->IsTraceHandleValid(LineOfSightTraceHandle, false))
+		{
+			LineOfSightTraceHandle = AsyncTraceLineOfSight(TargetedPoint->GetComponentLocation(),
+				FTraceDelegate::CreateUObject(this, &UTargetingSystemComponent::OnCheckTargetPointTraceComplete));
+		}
+		break;
+	case ETargetingLineOfSightMode::Shared:
+		if (IsSharedLineOfSightBlocked())
+		{
+			StartBreakingTargeting();
+		}
+		break;
+	}
+}
+
+void UTargetingSystemComponent::HandleWatchedTargetabilityChanged(UTargetPointComponent* TargetPoint)
+{
+	// Losing targetability is deliberate, e.g. the target died, so there is no BreakTargetingDelay grace period.
+	if (!TargetPoint->GetIsTargetable())
+	{
+		if (TargetedPoint == TargetPoint)
+		{
+			ClearTarget();
+		}
+
+		if (HasAuthority())
+		{
+			RemoveLockedTarget(TargetPoint);
+		}
+	}
+}
+
+void UTargetingSystemComponent::HandleWatchedTargetPointRemoved(UTargetPointComponent* TargetPoint)
+{
+	if (TargetedPoint == TargetPoint)
+	{
+		ClearTarget();
+	}
+
+	if (HasAuthority())
+	{
+		RemoveLockedTarget(TargetPoint);
+	}
+}
+
+bool UTargetingSystemComponent::ShouldBreakTargetingIgnoringLineOfSight() const
+{
 	if (!TargetedPoint)
 	{
 		return true;
@@ -458,35 +872,135 @@ bool UTargetingSystemComponent::ShouldBreakTargeting() const
 		return true;
 	}
 
-	FHitResult HitResult;
+	if (!IsWithinTargetingRange(TargetedPoint))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void UTargetingSystemComponent::StartBreakingTargeting()
+{
+	bIsBreakingLineOfSight = true;
+	GetWorld()->GetTimerManager().SetTimer(
+		BreakTargetPointTimerHandle,
+		this,
+		&UTargetingSystemComponent::BreakTargeting,
+		BreakTargetingDelay
+	);
+}
+
+void UTargetingSystemComponent::BreakTargeting()
+{
+	bIsBreakingLineOfSight = false;
+
+	if (ShouldBreakTargetingIgnoringLineOfSight())
+	{
+		ClearTarget();
+		return;
+	}
+
+	switch (LineOfSightMode)
+	{
+	case ETargetingLineOfSightMode::Synchronous:
+		if (IsLineOfSightBlocked(TargetedPoint->GetComponentLocation()))
+		{
+			ClearTarget();
+		}
+		break;
+	case ETargetingLineOfSightMode::Asynchronous:
+		LineOfSightTraceHandle = AsyncTraceLineOfSight(TargetedPoint->GetComponentLocation(),
+			FTraceDelegate::CreateUObject(this, &UTargetingSystemComponent::OnBreakTargetingTraceComplete));
+		break;
+	case ETargetingLineOfSightMode::Shared:
+		if (IsSharedLineOfSightBlocked())
+		{
+			ClearTarget();
+		}
+		break;
+	}
+}
+
+bool UTargetingSystemComponent::IsSharedLineOfSightBlocked() const
+{
+	bool bVisible = true;
+	if (const UTargetLineOfSightSubsystem* LineOfSight = UTargetLineOfSightSubsystem::Get(this))
+	{
+		LineOfSight->GetLineOfSight(OwnerPawn, TargetedPoint, bVisible);
+	}
+	return !bVisible;
+}
+
+void UTargetingSystemComponent::UpdateLineOfSightWatch()
+{
+	UTargetPointComponent* NewWatchedPoint = LineOfSightMode == ETargetingLineOfSightMode::Shared ? TargetedPoint.Get() : nullptr;
+	if (LineOfSightWatchedPoint == NewWatchedPoint)
+	{
+		return;
+	}
+
+	if (UTargetLineOfSightSubsystem* LineOfSight = UTargetLineOfSightSubsystem::Get(this))
+	{
+		if (LineOfSightWatchedPoint)
+		{
+			LineOfSight->RemoveWatch(OwnerPawn, LineOfSightWatchedPoint);
+		}
+		if (NewWatchedPoint)
+		{
+			LineOfSight->AddWatch(OwnerPawn, NewWatchedPoint);
+		}
+	}
+	LineOfSightWatchedPoint = NewWatchedPoint;
+}
+
+FCollisionQueryParams UTargetingSystemComponent::GetLineOfSightQueryParams() const
+{
 	FCollisionQueryParams Params = FCollisionQueryParams(FName("LineTraceSingle"));
 	Params.AddIgnoredActor(OwnerPawn);
+	return Params;
+}
 
-	bool BlockedHit = GetWorld()->LineTraceSingleByChannel(
+bool UTargetingSystemComponent::IsLineOfSightBlocked(const FVector& TargetLocation) const
+{
+	FHitResult HitResult;
+	return GetWorld()->LineTraceSingleByChannel(
 		HitResult,
 		OwnerPawn->GetActorLocation(),
-		TargetedPoint->GetComponentLocation(),
+		TargetLocation,
 		ECC_Visibility,
-		Params
+		GetLineOfSightQueryParams()
 	);
+}
 
-	if (BlockedHit)
-	{
-		return true;
-	}
+FTraceHandle UTargetingSystemComponent::AsyncTraceLineOfSight(const FVector& TargetLocation, const FTraceDelegate& OnComplete) const
+{
+	return GetWorld()->AsyncLineTraceByChannel(
+		EAsyncTraceType::Single,
+		OwnerPawn->GetActorLocation(),
+		TargetLocation,
+		ECC_Visibility,
+		GetLineOfSightQueryParams(),
+		FCollisionResponseParams::DefaultResponseParam,
+		&OnComplete
+	);
+}
+
+void UTargetingSystemComponent::OnCheckTargetPointTraceComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	LineOfSightTraceHandle = FTraceHandle();
 
-	if (GetDistanceToPoint(TargetedPoint) > MaxTargetingRange)
+	if (TargetedPoint && !bIsBreakingLineOfSight && FHitResult::GetFirstBlockingHit(TraceDatum.OutHits))
 	{
-		return true;
+		StartBreakingTargeting();
 	}
-
-	return false;
 }
 
-void UTargetingSystemComponent::BreakTargeting()
+void UTargetingSystemComponent::OnBreakTargetingTraceComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
 {
-	bIsBreakingLineOfSight = false;
-	if (ShouldBreakTargeting())
+	LineOfSightTraceHandle = FTraceHandle();
+
+	if (TargetedPoint && FHitResult::GetFirstBlockingHit(TraceDatum.OutHits))
 	{
 		ClearTarget();
 	}
@@ -570,28 +1084,86 @@ void UTargetingSystemComponent::CreateAndAttachTargetSelectedWidgetComponent(UTa
 		TargetWidgetClass = UTargetingSystemSettings::GetDefaultTargetWidgetClass();
 		if (!TargetWidgetClass)
 		{
-			UE_LOG(LogTargetingSystem, Error, TEXT("TargetSystemComponent: Cannot find a TargetWidgetClass, please ensure it is a valid reference in the Component Properties."));
+			// Still streaming in, HandleDefaultTargetWidgetClassLoaded creates the widget once it is resident.
+			if (!UTargetingSystemSettings::IsLoadingDefaultTargetWidgetClass())
+			{
+				UE_LOG(LogTargetingSystem, Error, TEXT("TargetSystemComponent: Cannot find a TargetWidgetClass, please ensure it is a valid reference in the Component Properties."));
+			}
 			return;
 		}
 	}
 
-	if (IsValid(TargetWidgetComponent))
+	if (!IsValid(OwnerPlayerController) || !OwnerPlayerController->IsLocalPlayerController() || !IsValid(InTargetPoint))
 	{
-		TargetWidgetComponent->DestroyComponent();
+		HideTargetWidgetComponent();
+		return;
 	}
-	
-	if (IsValid(OwnerPlayerController) && OwnerPlayerController->IsLocalPlayerController() && IsValid(InTargetPoint))
+
+	// The widget component is created once and moved between targets, so switching targets doesn't create a new
+	// component, widget and Slate tree every time.
+	if (!IsValid(TargetWidgetComponent))
 	{
-		TargetWidgetComponent = NewObject<UWidgetComponent>(InTargetPoint->GetOwner(), MakeUniqueObjectName(InTargetPoint->GetOwner(), UWidgetComponent::StaticClass(), FName("TargetLockOn")));
+		TargetWidgetComponent = NewObject<UWidgetComponent>(OwnerPawn, MakeUniqueObjectName(OwnerPawn, UWidgetComponent::StaticClass(), FName("TargetLockOn")));
 		TargetWidgetComponent->SetWidgetClass(TargetWidgetClass);
 		TargetWidgetComponent->SetOwnerPlayer(OwnerPlayerController->GetLocalPlayer());
 		TargetWidgetComponent->SetWidgetSpace(EWidgetSpace::Screen);
 		TargetWidgetComponent->SetupAttachment(InTargetPoint);
 		TargetWidgetComponent->SetDrawAtDesiredSize(true);
-		TargetWidgetComponent->SetVisibility(true);
 		TargetWidgetComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 		TargetWidgetComponent->RegisterComponent();
 	}
+	else if (TargetWidgetComponent->GetAttachParent() != InTargetPoint)
+	{
+		TargetWidgetComponent->AttachToComponent(InTargetPoint, FAttachmentTransformRules::SnapToTargetIncludingScale);
+	}
+
+	TargetWidgetComponent->SetVisibility(true);
+}
+
+void UTargetingSystemComponent::HandleDefaultTargetWidgetClassLoaded()
+{
+	UTargetingSystemSettings::OnDefaultTargetWidgetClassLoaded.RemoveAll(this);
+
+	if (!TargetWidgetClass)
+	{
+		TargetWidgetClass = UTargetingSystemSettings::GetDefaultTargetWidgetClass();
+	}
+
+	// A target locked while the class was loading didn't get its widget yet.
+	if (IsValid(TargetedPoint))
+	{
+		CreateAndAttachTargetSelectedWidgetComponent(TargetedPoint);
+	}
+}
+
+void UTargetingSystemComponent::HideTargetWidgetComponent()
+{
+	if (IsValid(TargetWidgetComponent))
+	{
+		TargetWidgetComponent->SetVisibility(false);
+		TargetWidgetComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+}
+
+void UTargetingSystemComponent::UpdateCandidateIndicator()
+{
+	if (!CandidateIndicator)
+	{
+		SetupLocalPlayerController();
+		if (!IsValid(OwnerPlayerController) || !OwnerPlayerController->IsLocalPlayerController())
+		{
+			return;
+		}
+
+		CandidateIndicator = CreateWidget<UTargetIndicatorWidget>(OwnerPlayerController, CandidateIndicatorClass);
+		CandidateIndicator->AddToPlayerScreen();
+	}
+
+	// The locked target already has its own widget.
+	TArray<UTargetPointComponent*, TInlineAllocator<FTargetPointCandidateList::InlineCapacity>> TargetPoints;
+	GatherTargetablePoints(ToRawPtrTArrayUnsafe(CandidateIndicatorFilters), TargetPoints);
+	TargetPoints.RemoveSingleSwap(TargetedPoint.Get(), EAllowShrinking::No);
+	CandidateIndicator->SetTargetPoints(TargetPoints);
 }
 
 void UTargetingSystemComponent::SetupLocalPlayerController()
@@ -602,8 +1174,17 @@ void UTargetingSystemComponent::SetupLocalPlayerController()
 	}
 }
 
-void UTargetingSystemComponent::OnRep_TargetedPoint()
+void UTargetingSystemComponent::OnRep_TargetedPoint(UTargetPointComponent* OldTargetedPoint)
+{
+	// Put the local target back, the reconciliation in PostRepNotifies decides whether the server's replaces it.
+	ConfirmedTargetedPoint = TargetedPoint;
+	TargetedPoint = OldTargetedPoint;
+	bTargetingStateReceived = true;
+}
+
+void UTargetingSystemComponent::ApplyTargetedPoint(UTargetPointComponent* NewTargetPoint)
 {
+	TargetedPoint = NewTargetPoint;
 	if (TargetedPoint)
 	{
 		OnTargetedPointSet();
@@ -615,10 +1196,151 @@ void UTargetingSystemComponent::OnRep_TargetedPoint()
 	OnTargetedPointUpdatedDelegate.Broadcast(TargetedPoint);
 }
 
-void UTargetingSystemComponent::OnRep_CameraLocked()
+void UTargetingSystemComponent::OnRep_AcknowledgedTargetPredictionKey()
 {
-	OnCameraLockSet();
-	OnCameraLockSetDelegate.Broadcast(bCameraLocked);
+	bTargetingStateReceived = true;
+	bTargetPredictionAcknowledged = true;
+}
+
+void UTargetingSystemComponent::PostRepNotifies()
+{
+	Super::PostRepNotifies();
+
+	if (!bTargetingStateReceived)
+	{
+		return;
+	}
+	const bool bAcknowledged = bTargetPredictionAcknowledged;
+	bTargetingStateReceived = false;
+	bTargetPredictionAcknowledged = false;
+
+	ReconcileTargetingState();
+
+	// Only an acknowledgement tells whether the server took the prediction, later changes are the server's own. Key 0
+	// is never sent, it is the initial value replicating before the first request.
+	if (bAcknowledged
+		&& AcknowledgedTargetPredictionKey != 0
+		&& !HasPendingTargetPrediction()
+		&& PredictedState.TargetPoint != ConfirmedTargetedPoint)
+	{
+		UTargetPointComponent* RejectedTarget = PredictedState.TargetPoint;
+		PredictedState.TargetPoint = ConfirmedTargetedPoint;
+		OnTargetRejectedDelegate.Broadcast(RejectedTarget);
+	}
+}
+
+bool UTargetingSystemComponent::IsPredictingTargetingState() const
+{
+	return !HasAuthority() && GetOwnerRole() == ROLE_AutonomousProxy;
+}
+
+bool UTargetingSystemComponent::PrepareTargetingStateChange()
+{
+	if (HasAuthority())
+	{
+		return true;
+	}
+	if (!IsPredictingTargetingState())
+	{
+		return false;
+	}
+	MarkTargetingStateDirty();
+	return true;
+}
+
+void UTargetingSystemComponent::MarkTargetingStateDirty()
+{
+	// The key changes right away so replicated state older than this frame's changes doesn't overwrite them. It skips
+	// 0 when wrapping, 0 means no request was made.
+	if (!bTargetingStateDirty)
+	{
+		bTargetingStateDirty = true;
+		if (++TargetPredictionKey == 0)
+		{
+			TargetPredictionKey++;
+		}
+	}
+}
+
+void UTargetingSystemComponent::UpdateTargetingStateRequest()
+{
+	if (!IsPredictingTargetingState() || !HasPendingTargetPrediction())
+	{
+		return;
+	}
+
+	// The state is sent once per frame at most, so chained changes such as clearing the target and the camera lock
+	// share one request. The latest request is resent until the server acknowledges it.
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (bTargetingStateDirty)
+	{
+		bTargetingStateDirty = false;
+		PredictedState.TargetPoint = TargetedPoint;
+		PredictedState.bCameraLocked = bCameraLocked;
+		PredictedState.PredictionKey = TargetPredictionKey;
+	}
+	else if (Now - LastTargetingStateRequestTime < GetDefault<UTargetingSystemSettings>()->TargetRequestResendInterval)
+	{
+		return;
+	}
+
+	LastTargetingStateRequestTime = Now;
+	Server_RequestTargetingState(PredictedState);
+}
+
+void UTargetingSystemComponent::ReconcileTargetingState()
+{
+	// Until the server has processed the latest request its state is stale, keep the prediction.
+	if (HasPendingTargetPrediction())
+	{
+		return;
+	}
+
+	if (TargetedPoint != ConfirmedTargetedPoint)
+	{
+		ApplyTargetedPoint(ConfirmedTargetedPoint);
+	}
+	if (bCameraLocked != bConfirmedCameraLocked)
+	{
+		ApplyCameraLock(bConfirmedCameraLocked);
+	}
+}
+
+void UTargetingSystemComponent::OnRep_CameraLocked(bool bOldCameraLocked)
+{
+	bConfirmedCameraLocked = bCameraLocked;
+	bCameraLocked = bOldCameraLocked;
+	bTargetingStateReceived = true;
+}
+
+void UTargetingSystemComponent::OnRep_LockedTargets()
+{
+	UpdateValidationRegistration();
+	OnLockedTargetsChangedDelegate.Broadcast();
+}
+
+bool UTargetingSystemComponent::IsLockedTargetValid(const UTargetPointComponent* TargetPoint) const
+{
+	return IsValid(TargetPoint) && TargetPoint->GetIsTargetable() && IsWithinTargetingRange(TargetPoint);
+}
+
+void UTargetingSystemComponent::ValidateLockedTargets()
+{
+	bool bRemoved = false;
+	for (int32 Index = LockedTargets.Items.Num() - 1; Index >= 0; Index--)
+	{
+		if (!IsLockedTargetValid(LockedTargets.Items[Index].TargetPoint))
+		{
+			LockedTargets.Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			bRemoved = true;
+		}
+	}
+
+	if (bRemoved)
+	{
+		LockedTargets.MarkArrayDirty();
+		OnRep_LockedTargets();
+	}
 }
 
 void UTargetingSystemComponent::OnTargetPointOwnerDestroyed(AActor* DestroyedActor)
@@ -626,17 +1348,56 @@ void UTargetingSystemComponent::OnTargetPointOwnerDestroyed(AActor* DestroyedAct
 	ClearTarget();
 }
 
-void UTargetingSystemComponent::Server_SetCameraLock_Implementation(bool bLocked)
+void UTargetingSystemComponent::Server_RequestTargetingState_Implementation(const FTargetingStateRequest& Request)
 {
-	SetCameraLock(bLocked);
+	// Unreliable requests can arrive late, out of order or twice. Only the newest one counts.
+	if (!IsNewerTargetPredictionKey(Request.PredictionKey, AcknowledgedTargetPredictionKey))
+	{
+		return;
+	}
+
+	if (UTargetValidationSubsystem* Subsystem = UTargetValidationSubsystem::Get(this))
+	{
+		Subsystem->QueueTargetRequest(this, Request);
+	}
+	else
+	{
+		ResolveTargetingStateRequest(Request, true);
+	}
 }
 
-void UTargetingSystemComponent::Server_ClearTarget_Implementation()
+bool UTargetingSystemComponent::ResolveTargetingStateRequest(const FTargetingStateRequest& Request, bool bAccepted)
 {
-	ClearTarget();
+	if (!IsNewerTargetPredictionKey(Request.PredictionKey, AcknowledgedTargetPredictionKey))
+	{
+		return false;
+	}
+
+	// The TargetPoint can stop being targetable or be destroyed while the request waits for validation. The camera
+	// lock only comes with the requested target and never without a target, otherwise the whole request is rejected
+	// and the client rolls back to the server's state.
+	const bool bApplied = bAccepted
+		&& SetTarget(Request.TargetPoint)
+		&& (TargetedPoint != nullptr || !Request.bCameraLocked);
+	if (bApplied)
+	{
+		SetCameraLock(Request.bCameraLocked);
+	}
+	AcknowledgedTargetPredictionKey = Request.PredictionKey;
+	return bApplied;
+}
+
+void UTargetingSystemComponent::Server_SetLockedTargets_Implementation(const TArray<UTargetPointComponent*>& TargetPoints)
+{
+	SetLockedTargets(TargetPoints);
+}
+
+void UTargetingSystemComponent::Server_AddLockedTarget_Implementation(UTargetPointComponent* TargetPoint)
+{
+	AddLockedTarget(TargetPoint);
 }
 
-void UTargetingSystemComponent::Server_SetTarget_Implementation(UTargetPointComponent* NewTargetPoint)
+void UTargetingSystemComponent::Server_RemoveLockedTarget_Implementation(UTargetPointComponent* TargetPoint)
 {
-	SetTarget(NewTargetPoint);
+	RemoveLockedTarget(TargetPoint);
 }
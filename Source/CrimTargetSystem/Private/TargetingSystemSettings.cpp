@@ -7,6 +7,13 @@
 #include "Blueprint/UserWidget.h"
 #include "Engine/AssetManager.h"
 
+FSimpleMulticastDelegate UTargetingSystemSettings::OnDefaultTargetWidgetClassLoaded;
+
+namespace
+{
+	TSharedPtr<FStreamableHandle> DefaultTargetWidgetClassHandle;
+}
+
 UTargetingSystemSettings::UTargetingSystemSettings()
 {
 	TargetWidgetClass  = TSoftClassPtr<UUserWidget>(FSoftClassPath(
@@ -19,6 +26,11 @@ FName UTargetingSystemSettings::GetCategoryName() const
 }
 
 TSubclassOf<UUserWidget> UTargetingSystemSettings::GetDefaultTargetWidgetClass()
+{
+	return GetDefault<UTargetingSystemSettings>()->TargetWidgetClass.Get();
+}
+
+void UTargetingSystemSettings::LoadDefaultTargetWidgetClass()
 {
 	const UTargetingSystemSettings* Settings = GetDefault<UTargetingSystemSettings>();
 
@@ -26,12 +38,35 @@ TSubclassOf<UUserWidget> UTargetingSystemSettings::GetDefaultTargetWidgetClass()
 	{
 		UE_LOG(LogTargetingSystem, Error, TEXT("UTargetingSystemSettings.TargetWidgetClass is not valid. "
 			"Set a value in the project settings."));
+		return;
 	}
 
-	if (!Settings->TargetWidgetClass.Get())
+	if (Settings->TargetWidgetClass.Get() || IsLoadingDefaultTargetWidgetClass() || !UAssetManager::IsInitialized())
 	{
-		UAssetManager::Get().LoadAssetList({Settings->TargetWidgetClass.ToSoftObjectPath()})->WaitUntilComplete();
+		return;
 	}
 
-	return Settings->TargetWidgetClass.Get();
+	// The handle is kept so the class stays loaded.
+	DefaultTargetWidgetClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		Settings->TargetWidgetClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateLambda([]()
+		{
+			OnDefaultTargetWidgetClassLoaded.Broadcast();
+		}));
+}
+
+bool UTargetingSystemSettings::IsLoadingDefaultTargetWidgetClass()
+{
+	return DefaultTargetWidgetClassHandle.IsValid() && DefaultTargetWidgetClassHandle->IsLoadingInProgress();
+}
+
+void UTargetingSystemSettings::ReleaseDefaultTargetWidgetClass()
+{
+	if (DefaultTargetWidgetClassHandle.IsValid())
+	{
+		// Cancelling also stops the completion delegate from broadcasting into an unloaded module.
+		DefaultTargetWidgetClassHandle->CancelHandle();
+		DefaultTargetWidgetClassHandle.Reset();
+	}
+	OnDefaultTargetWidgetClassLoaded.Clear();
 }
@@ -4,32 +4,90 @@
 #include "TargetingSystemTypes.h"
 
 #include "TargetPointComponent.h"
+#include "TargetPointManagerComponent.h"
+#include "TargetingSystemComponent.h"
+#include "Algo/Sort.h"
 
 const TArray<FTargetPointItem>& FTargetPointContainer::GetAllItems() const
 {
 	return Items;
 }
 
-void FTargetPointContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+bool FTargetPointTargetableMask::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	for (const int32 Index : AddedIndices)
+	uint32 NumBits = Bits.Num();
+	Ar.SerializeIntPacked(NumBits);
+
+	if (Ar.IsLoading())
 	{
-		FTargetPointItem& Item = Items[Index];
-		if (IsValid(Item.TargetPointComponent))
+		if (NumBits > MaxNumBits)
 		{
-			Item.TargetPointComponent->SetIsTargetable(Item.bCanBeTargeted);
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
 		}
+		Bits.Init(false, NumBits);
+	}
+
+	if (NumBits > 0)
+	{
+		Ar.SerializeBits(Bits.GetData(), NumBits);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+void FTargetPointContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	if (!IsValid(Owner))
+	{
+		return;
+	}
+
+	for (const int32 Index : AddedIndices)
+	{
+		Owner->ApplyTargetability(Items[Index]);
 	}
 }
 
 void FTargetPointContainer::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
+	if (!IsValid(Owner))
+	{
+		return;
+	}
+
 	for (const int32 Index : ChangedIndices)
 	{
-		FTargetPointItem& Item = Items[Index];
-		if (IsValid(Item.TargetPointComponent))
+		Owner->ApplyTargetability(Items[Index]);
+	}
+}
+
+void FLockedTargetContainer::GetTargetPoints(TArray<UTargetPointComponent*>& OutTargetPoints) const
+{
+	TArray<const FLockedTargetItem*, TInlineAllocator<8>> SortedItems;
+	for (const FLockedTargetItem& Item : Items)
+	{
+		SortedItems.Add(&Item);
+	}
+	Algo::SortBy(SortedItems, &FLockedTargetItem::LockOrder);
+
+	OutTargetPoints.Reset(SortedItems.Num());
+	for (const FLockedTargetItem* Item : SortedItems)
+	{
+		// Skip locks whose TargetPoint hasn't replicated yet.
+		if (Item->TargetPoint)
 		{
-			Item.TargetPointComponent->SetIsTargetable(Item.bCanBeTargeted);	
+			OutTargetPoints.Add(Item->TargetPoint);
 		}
 	}
-}
\ No newline at end of file
+}
+
+void FLockedTargetContainer::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (IsValid(Owner))
+	{
+		Owner->OnRep_LockedTargets();
+	}
+}
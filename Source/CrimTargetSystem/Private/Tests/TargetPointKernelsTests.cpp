@@ -0,0 +1,279 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetPointKernels.h"
+
+#include "TargetingSystemLogChannels.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TargetPointKernelsTests
+{
+	/** Structure-of-arrays locations in a box of the given half extent, like the candidates of a query. */
+	struct FLocations
+	{
+		TArray<float> X;
+		TArray<float> Y;
+		TArray<float> Z;
+
+		int32 Num() const { return X.Num(); }
+
+		void Fill(int32 Num, float HalfExtent, int32 Seed)
+		{
+			FRandomStream Random(Seed);
+			X.Reset(Num);
+			Y.Reset(Num);
+			Z.Reset(Num);
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				X.Add(Random.FRandRange(-HalfExtent, HalfExtent));
+				Y.Add(Random.FRandRange(-HalfExtent, HalfExtent));
+				Z.Add(Random.FRandRange(-HalfExtent * 0.1f, HalfExtent * 0.1f));
+			}
+		}
+	};
+
+	/** The vectorized kernels use fused multiply-adds, so locations right on the cone's edge may round either way. */
+	bool IsOnConeEdge(const FLocations& Locations, int32 Index, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle)
+	{
+		const FVector3f Offset = FVector3f(Locations.X[Index], Locations.Y[Index], Locations.Z[Index]) - Origin;
+		return FMath::IsNearlyEqual(Offset.GetSafeNormal() | Direction, CosHalfAngle, 1.e-4f);
+	}
+
+	/** The signed acos angle ordering FindNextAround replaced. Kept as the baseline it is measured against. */
+	int32 FindNextAroundAcos(const float* X, const float* Y, int32 Num, const FVector2f& Origin, const FVector2f& Reference, bool bSearchLeft)
+	{
+		const FVector2f ReferenceDirection = Reference.GetSafeNormal();
+		float RightComparison = bSearchLeft ? 0.f : 180.f;
+		float LeftComparison = bSearchLeft ? -180.f : 0.f;
+		int32 RightIndex = INDEX_NONE;
+		int32 LeftIndex = INDEX_NONE;
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const FVector2f Offset = FVector2f(X[Index] - Origin.X, Y[Index] - Origin.Y).GetSafeNormal();
+			const float Angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ReferenceDirection | Offset, -1.f, 1.f))) *
+				FMath::Sign(ReferenceDirection ^ Offset);
+
+			if (!bSearchLeft)
+			{
+				if (Angle > 0.f && Angle < RightComparison)
+				{
+					RightComparison = Angle;
+					RightIndex = Index;
+				}
+				else if (Angle < 0.f && Angle < LeftComparison)
+				{
+					LeftComparison = Angle;
+					LeftIndex = Index;
+				}
+			}
+			else
+			{
+				if (Angle > 0.f && Angle > RightComparison)
+				{
+					RightComparison = Angle;
+					RightIndex = Index;
+				}
+				else if (Angle < 0.f && Angle > LeftComparison)
+				{
+					LeftComparison = Angle;
+					LeftIndex = Index;
+				}
+			}
+		}
+
+		if (!bSearchLeft)
+		{
+			return RightIndex != INDEX_NONE ? RightIndex : LeftIndex;
+		}
+		return LeftIndex != INDEX_NONE ? LeftIndex : RightIndex;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetPointKernelsMatchScalarTest, "TargetingSystem.Kernels.MatchScalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetPointKernelsMatchScalarTest::RunTest(const FString& Parameters)
+{
+	using namespace TargetPointKernelsTests;
+
+	// Counts around the register width to cover the remainder loops.
+	const int32 Counts[] = { 0, 1, 3, 4, 5, 63, 64, 65, 1000 };
+	const float CosHalfAngles[] = { 0.99f, 0.7f, 0.f, -0.5f };
+
+	FRandomStream Random(91);
+	FLocations Locations;
+	TArray<uint8> ScalarInCone;
+	TArray<uint8> VectorizedInCone;
+	for (const int32 Count : Counts)
+	{
+		Locations.Fill(Count, 10000.f, Count);
+
+		for (int32 Query = 0; Query < 20; Query++)
+		{
+			const FVector3f Origin(Random.FRandRange(-10000.f, 10000.f), Random.FRandRange(-10000.f, 10000.f), 0.f);
+
+			float ScalarDistanceSquared;
+			float VectorizedDistanceSquared;
+			const int32 ScalarIndex = TargetPointKernels::FindNearestScalar(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, ScalarDistanceSquared);
+			const int32 VectorizedIndex = TargetPointKernels::FindNearestVectorized(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, VectorizedDistanceSquared);
+
+			TestEqual(TEXT("FindNearest finds a location whenever there is one"), VectorizedIndex == INDEX_NONE, ScalarIndex == INDEX_NONE);
+			if (ScalarIndex != INDEX_NONE && VectorizedIndex != INDEX_NONE)
+			{
+				TestTrue(FString::Printf(TEXT("FindNearest distance with %d locations"), Count),
+					FMath::IsNearlyEqual(ScalarDistanceSquared, VectorizedDistanceSquared, ScalarDistanceSquared * 1.e-5f));
+			}
+
+			const FVector3f Direction = FVector3f(Random.VRand()).GetSafeNormal();
+			for (const float CosHalfAngle : CosHalfAngles)
+			{
+				ScalarInCone.SetNumUninitialized(Count);
+				VectorizedInCone.SetNumUninitialized(Count);
+				TargetPointKernels::ConeTestScalar(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, Direction, CosHalfAngle, ScalarInCone.GetData());
+				TargetPointKernels::ConeTestVectorized(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, Direction, CosHalfAngle, VectorizedInCone.GetData());
+
+				for (int32 Index = 0; Index < Count; Index++)
+				{
+					if (ScalarInCone[Index] != VectorizedInCone[Index] && !IsOnConeEdge(Locations, Index, Origin, Direction, CosHalfAngle))
+					{
+						AddError(FString::Printf(TEXT("ConeTest differs at index %d of %d with a half angle cosine of %.2f"), Index, Count, CosHalfAngle));
+						return false;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetPointKernelsBenchmark, "TargetingSystem.Kernels.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FTargetPointKernelsBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace TargetPointKernelsTests;
+
+	// Roughly the same number of locations visited for every count, so the timings are comparable.
+	constexpr int32 LocationsPerCount = 10000000;
+	const int32 Counts[] = { 16, 64, 1000, 10000 };
+
+	FLocations Locations;
+	TArray<uint8> InCone;
+	for (const int32 Count : Counts)
+	{
+		Locations.Fill(Count, 10000.f, Count);
+		InCone.SetNumUninitialized(Count);
+		const int32 NumQueries = LocationsPerCount / Count;
+		const FVector3f Origin(100.f, -200.f, 0.f);
+		const FVector3f Direction(1.f, 0.f, 0.f);
+
+		// Accumulated so the compiler can't drop the calls.
+		int64 Checksum = 0;
+		float DistanceSquared;
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			Checksum += TargetPointKernels::FindNearestScalar(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, DistanceSquared);
+		}
+		const double FindNearestScalarSeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			Checksum -= TargetPointKernels::FindNearestVectorized(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, DistanceSquared);
+		}
+		const double FindNearestVectorizedSeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			TargetPointKernels::ConeTestScalar(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, Direction, 0.7f, InCone.GetData());
+			Checksum += InCone[Query % Count];
+		}
+		const double ConeTestScalarSeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			TargetPointKernels::ConeTestVectorized(Locations.X.GetData(), Locations.Y.GetData(), Locations.Z.GetData(), Count, Origin, Direction, 0.7f, InCone.GetData());
+			Checksum -= InCone[Query % Count];
+		}
+		const double ConeTestVectorizedSeconds = FPlatformTime::Seconds() - Start;
+
+		TestEqual(TEXT("Scalar and vectorized kernels agree"), Checksum, static_cast<int64>(0));
+		UE_LOG(LogTargetingSystem, Display, TEXT("Kernels: %d locations: FindNearest scalar %.3f us, vectorized %.3f us (%.2fx). ConeTest scalar %.3f us, vectorized %.3f us (%.2fx)"),
+			Count,
+			FindNearestScalarSeconds * 1e6 / NumQueries, FindNearestVectorizedSeconds * 1e6 / NumQueries, FindNearestScalarSeconds / FMath::Max(FindNearestVectorizedSeconds, UE_SMALL_NUMBER),
+			ConeTestScalarSeconds * 1e6 / NumQueries, ConeTestVectorizedSeconds * 1e6 / NumQueries, ConeTestScalarSeconds / FMath::Max(ConeTestVectorizedSeconds, UE_SMALL_NUMBER));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetPointSwitchOrderingBenchmark, "TargetingSystem.Kernels.SwitchOrderingBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FTargetPointSwitchOrderingBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace TargetPointKernelsTests;
+
+	constexpr int32 NumCandidates = 1000;
+	constexpr int32 NumQueries = 10000;
+
+	FLocations Locations;
+	Locations.Fill(NumCandidates, 10000.f, 17);
+	const FVector2f Origin(0.f, 0.f);
+
+	// Both orderings are monotonic in the same angle. Acos loses precision near small angles, so candidates only
+	// differ when they are at nearly the same angle from the reference.
+	FRandomStream Random(23);
+	for (int32 Query = 0; Query < 100; Query++)
+	{
+		const FVector2f Reference = FVector2f(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f));
+		const bool bSearchLeft = Query % 2 == 0;
+		const int32 PseudoAngleIndex = TargetPointKernels::FindNextAround(Locations.X.GetData(), Locations.Y.GetData(), NumCandidates, Origin, Reference, bSearchLeft);
+		const int32 AcosIndex = FindNextAroundAcos(Locations.X.GetData(), Locations.Y.GetData(), NumCandidates, Origin, Reference, bSearchLeft);
+		if (!TestTrue(TEXT("Both orderings find a candidate"), PseudoAngleIndex != INDEX_NONE && AcosIndex != INDEX_NONE))
+		{
+			return false;
+		}
+
+		const double PseudoAngleHeading = FMath::Atan2(static_cast<double>(Locations.Y[PseudoAngleIndex]), static_cast<double>(Locations.X[PseudoAngleIndex]));
+		const double AcosHeading = FMath::Atan2(static_cast<double>(Locations.Y[AcosIndex]), static_cast<double>(Locations.X[AcosIndex]));
+		TestTrue(TEXT("Pseudo angle and acos pick the same candidate"), FMath::Abs(FMath::FindDeltaAngleRadians(PseudoAngleHeading, AcosHeading)) < 1.e-3);
+	}
+
+	// Accumulated so the compiler can't drop the calls.
+	int64 Checksum = 0;
+
+	Random.Reset();
+	double Start = FPlatformTime::Seconds();
+	for (int32 Query = 0; Query < NumQueries; Query++)
+	{
+		const FVector2f Reference = FVector2f(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f));
+		Checksum += FindNextAroundAcos(Locations.X.GetData(), Locations.Y.GetData(), NumCandidates, Origin, Reference, Query % 2 == 0);
+	}
+	const double AcosSeconds = FPlatformTime::Seconds() - Start;
+
+	Random.Reset();
+	Start = FPlatformTime::Seconds();
+	for (int32 Query = 0; Query < NumQueries; Query++)
+	{
+		const FVector2f Reference = FVector2f(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f));
+		Checksum -= TargetPointKernels::FindNextAround(Locations.X.GetData(), Locations.Y.GetData(), NumCandidates, Origin, Reference, Query % 2 == 0);
+	}
+	const double PseudoAngleSeconds = FPlatformTime::Seconds() - Start;
+
+	UE_LOG(LogTargetingSystem, Verbose, TEXT("SwitchOrdering checksum %lld"), Checksum);
+	UE_LOG(LogTargetingSystem, Display, TEXT("SwitchOrdering: %d candidates: acos %.2f us/query, pseudo angle %.2f us/query (%.2fx)"),
+		NumCandidates, AcosSeconds * 1e6 / NumQueries, PseudoAngleSeconds * 1e6 / NumQueries, AcosSeconds / FMath::Max(PseudoAngleSeconds, UE_SMALL_NUMBER));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,216 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetPointSpatialHash.h"
+
+#include "TargetingSystemTestWorld.h"
+#include "TargetingSystemLogChannels.h"
+#include "TargetPointSubsystem.h"
+#include "TargetingSystemSettings.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TargetPointSpatialHashTests
+{
+	/** Fills the grid with random locations in a cube of the given half extent. */
+	void FillGrid(FTargetPointSpatialHash& SpatialHash, TArray<FVector>& Locations, int32 Num, double HalfExtent, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		Locations.Reset(Num);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const FVector Location(
+				Random.FRandRange(-HalfExtent, HalfExtent),
+				Random.FRandRange(-HalfExtent, HalfExtent),
+				Random.FRandRange(-HalfExtent * 0.1, HalfExtent * 0.1));
+			Locations.Add(Location);
+			SpatialHash.Add(Index, SpatialHash.GetCell(Location));
+		}
+	}
+
+	void GatherGrid(const FTargetPointSpatialHash& SpatialHash, TConstArrayView<FVector> Locations, const FVector& Origin, double Radius, TArray<int32>& OutIndices)
+	{
+		const double RadiusSquared = Radius * Radius;
+		OutIndices.Reset();
+		SpatialHash.ForEachInRange(Origin, Radius, [&](const int32 Index)
+		{
+			if (FVector::DistSquared(Origin, Locations[Index]) <= RadiusSquared)
+			{
+				OutIndices.Add(Index);
+			}
+		});
+	}
+
+	void GatherBruteForce(TConstArrayView<FVector> Locations, const FVector& Origin, double Radius, TArray<int32>& OutIndices)
+	{
+		const double RadiusSquared = Radius * Radius;
+		OutIndices.Reset();
+		for (int32 Index = 0; Index < Locations.Num(); Index++)
+		{
+			if (FVector::DistSquared(Origin, Locations[Index]) <= RadiusSquared)
+			{
+				OutIndices.Add(Index);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetPointSpatialHashMatchesBruteForceTest, "TargetingSystem.SpatialHash.MatchesBruteForce",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetPointSpatialHashMatchesBruteForceTest::RunTest(const FString& Parameters)
+{
+	using namespace TargetPointSpatialHashTests;
+
+	FTargetPointSpatialHash SpatialHash;
+	SpatialHash.SetCellSize(1000.0);
+	TArray<FVector> Locations;
+	FillGrid(SpatialHash, Locations, 2000, 20000.0, 1234);
+
+	// Radii below, around and far above the cell size, the largest taking the occupied cell path.
+	const double Radii[] = { 10.0, 500.0, 1000.0, 2500.0, 8000.0, 100000.0 };
+
+	FRandomStream Random(5678);
+	TArray<int32> GridIndices;
+	TArray<int32> BruteForceIndices;
+	for (const double Radius : Radii)
+	{
+		for (int32 Query = 0; Query < 50; Query++)
+		{
+			const FVector Origin(Random.FRandRange(-25000.0, 25000.0), Random.FRandRange(-25000.0, 25000.0), Random.FRandRange(-3000.0, 3000.0));
+			GatherGrid(SpatialHash, Locations, Origin, Radius, GridIndices);
+			GatherBruteForce(Locations, Origin, Radius, BruteForceIndices);
+
+			GridIndices.Sort();
+			if (!TestEqual(FString::Printf(TEXT("Indices within %.0f of %s"), Radius, *Origin.ToString()), GridIndices, BruteForceIndices))
+			{
+				return false;
+			}
+		}
+	}
+
+	// Moving indices keeps the grid in sync.
+	for (int32 Index = 0; Index < Locations.Num(); Index += 3)
+	{
+		const FVector NewLocation = Locations[Index] + FVector(1500.0, -700.0, 0.0);
+		SpatialHash.Move(Index, SpatialHash.GetCell(Locations[Index]), SpatialHash.GetCell(NewLocation));
+		Locations[Index] = NewLocation;
+	}
+	GatherGrid(SpatialHash, Locations, FVector::ZeroVector, 5000.0, GridIndices);
+	GatherBruteForce(Locations, FVector::ZeroVector, 5000.0, BruteForceIndices);
+	GridIndices.Sort();
+	TestEqual(TEXT("Indices after moving"), GridIndices, BruteForceIndices);
+
+	// Removing an index swaps the last one into its place, as the TargetPointSubsystem does.
+	for (int32 Removal = 0; Removal < 500; Removal++)
+	{
+		const int32 Index = Random.RandHelper(Locations.Num());
+		const int32 LastIndex = Locations.Num() - 1;
+		SpatialHash.Remove(Index, SpatialHash.GetCell(Locations[Index]));
+		if (Index != LastIndex)
+		{
+			SpatialHash.Reindex(LastIndex, Index, SpatialHash.GetCell(Locations[LastIndex]));
+		}
+		Locations.RemoveAtSwap(Index);
+	}
+	for (const double Radius : Radii)
+	{
+		GatherGrid(SpatialHash, Locations, FVector::ZeroVector, Radius, GridIndices);
+		GatherBruteForce(Locations, FVector::ZeroVector, Radius, BruteForceIndices);
+		GridIndices.Sort();
+		TestEqual(FString::Printf(TEXT("Indices within %.0f after removing"), Radius), GridIndices, BruteForceIndices);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetPointSubsystemRebucketingTest, "TargetingSystem.SpatialHash.SubsystemRebucketing",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetPointSubsystemRebucketingTest::RunTest(const FString& Parameters)
+{
+	FTargetingSystemTestWorld TestWorld;
+	const UTargetPointSubsystem* Subsystem = UTargetPointSubsystem::Get(TestWorld.World);
+	if (!TestNotNull(TEXT("The game world has a TargetPointSubsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	UTargetPointComponent* MovingPoint = TestWorld.SpawnTargetPoint(FVector(100.0, 100.0, 0.0));
+	UTargetPointComponent* LastPoint = TestWorld.SpawnTargetPoint(FVector(-100.0, -100.0, 0.0));
+
+	// Moving the TargetPoint several cells away goes through OnUpdateTransform, which moves it to its new cell.
+	const FVector OldLocation = MovingPoint->GetComponentLocation();
+	const FVector NewLocation = OldLocation + FVector(3.0 * GetDefault<UTargetingSystemSettings>()->TargetPointGridCellSize, 0.0, 0.0);
+	MovingPoint->SetWorldLocation(NewLocation);
+
+	TArray<UTargetPointComponent*> Found;
+	Subsystem->GetTargetPointsInRange(NewLocation, 50.f, Found);
+	TestTrue(TEXT("A moved TargetPoint is found at its new location"), Found.Contains(MovingPoint));
+	Found.Reset();
+	Subsystem->GetTargetPointsInRange(OldLocation, 50.f, Found);
+	TestFalse(TEXT("A moved TargetPoint isn't found at its old location"), Found.Contains(MovingPoint));
+
+	// Unregistering the first TargetPoint swaps the last one into its index, which must still be found.
+	MovingPoint->DestroyComponent();
+	Found.Reset();
+	Subsystem->GetTargetPointsInRange(NewLocation, 50.f, Found);
+	TestTrue(TEXT("An unregistered TargetPoint isn't found"), Found.IsEmpty());
+	Found.Reset();
+	Subsystem->GetTargetPointsInRange(LastPoint->GetComponentLocation(), 50.f, Found);
+	TestTrue(TEXT("The swapped TargetPoint is still found"), Found.Contains(LastPoint));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetPointSpatialHashBenchmark, "TargetingSystem.SpatialHash.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FTargetPointSpatialHashBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace TargetPointSpatialHashTests;
+
+	constexpr int32 NumQueries = 1000;
+	const int32 Counts[] = { 1000, 10000, 50000 };
+	const double Radii[] = { 2000.0, 50000.0 };
+
+	TArray<int32> Indices;
+	for (const int32 Count : Counts)
+	{
+		FTargetPointSpatialHash SpatialHash;
+		TArray<FVector> Locations;
+		FillGrid(SpatialHash, Locations, Count, 50000.0, Count);
+
+		for (const double Radius : Radii)
+		{
+			FRandomStream Random(42);
+			int32 NumFound = 0;
+
+			const double GridStart = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumQueries; Query++)
+			{
+				GatherGrid(SpatialHash, Locations, FVector(Random.FRandRange(-50000.0, 50000.0), Random.FRandRange(-50000.0, 50000.0), 0.0), Radius, Indices);
+				NumFound += Indices.Num();
+			}
+			const double GridSeconds = FPlatformTime::Seconds() - GridStart;
+
+			Random.Reset();
+			const double BruteForceStart = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumQueries; Query++)
+			{
+				GatherBruteForce(Locations, FVector(Random.FRandRange(-50000.0, 50000.0), Random.FRandRange(-50000.0, 50000.0), 0.0), Radius, Indices);
+				NumFound -= Indices.Num();
+			}
+			const double BruteForceSeconds = FPlatformTime::Seconds() - BruteForceStart;
+
+			TestEqual(TEXT("Grid and brute force find the same points"), NumFound, 0);
+			UE_LOG(LogTargetingSystem, Display, TEXT("SpatialHash: %d points, radius %.0f: grid %.2f us/query, brute force %.2f us/query"),
+				Count, Radius, GridSeconds * 1e6 / NumQueries, BruteForceSeconds * 1e6 / NumQueries);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,187 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetingSystemTestWorld.h"
+
+#include "TargetPointQueryTypes.h"
+#include "Filter/TargetPointFilter_Cone.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TargetingSystemAllocationTests
+{
+	/**
+	 * Forwards to the wrapped allocator and counts the allocations made by the thread that created it. Other threads
+	 * keep allocating while the test runs, so they are ignored.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+			, ThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+		}
+
+		int32 GetNumAllocations() const { return NumAllocations; }
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation(Size);
+			return InnerMalloc->Malloc(Size, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation(Size);
+			return InnerMalloc->TryMalloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation(Size);
+			return InnerMalloc->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation(Size);
+			return InnerMalloc->TryRealloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Size, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return InnerMalloc->GetDescriptiveName();
+		}
+
+	private:
+		FMalloc* InnerMalloc;
+		uint32 ThreadId;
+		int32 NumAllocations = 0;
+
+		void CountAllocation(SIZE_T Size)
+		{
+			if (Size > 0 && FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				NumAllocations++;
+			}
+		}
+	};
+
+	/** Installs a FCountingMalloc for its lifetime. */
+	struct FScopedAllocationCounter
+	{
+		FCountingMalloc CountingMalloc;
+		FMalloc* PreviousMalloc;
+
+		FScopedAllocationCounter()
+			: CountingMalloc(GMalloc)
+			, PreviousMalloc(GMalloc)
+		{
+			GMalloc = &CountingMalloc;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			GMalloc = PreviousMalloc;
+		}
+
+		int32 GetNumAllocations() const { return CountingMalloc.GetNumAllocations(); }
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetingSystemQueryAllocationTest, "TargetingSystem.Queries.NoAllocations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetingSystemQueryAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace TargetingSystemAllocationTests;
+
+	FTargetingSystemTestWorld TestWorld;
+	UTargetingSystemComponent* TargetingSystem = TestWorld.SpawnTargetingPawn(FVector::ZeroVector);
+
+	// Fewer TargetPoints than the candidate list's inline capacity, spread around the pawn so the cone keeps some.
+	constexpr int32 NumTargetPoints = 32;
+	TArray<UTargetPointComponent*> TargetPoints;
+	for (int32 Index = 0; Index < NumTargetPoints; Index++)
+	{
+		const double Angle = UE_TWO_PI * Index / NumTargetPoints;
+		TargetPoints.Add(TestWorld.SpawnTargetPoint(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0) * 1000.0));
+	}
+
+	TArray<UTargetPointFilterBase*> Filters;
+	Filters.Add(NewObject<UTargetPointFilter_Cone>(GetTransientPackage()));
+
+	// Warm up, so anything lazily created on the first query doesn't count.
+	TArray<UTargetPointComponent*, TInlineAllocator<FTargetPointCandidateList::InlineCapacity>> Found;
+	FTargetPointCandidateList Candidates;
+	TargetingSystem->GatherTargetablePoints(Filters, Found);
+	TargetingSystem->GatherTargetablePoints(Filters, Candidates);
+	TargetingSystem->FindNearestTarget(Filters);
+	if (!TestTrue(TEXT("The cone keeps some TargetPoints"), Found.Num() > 0 && Found.Num() < NumTargetPoints))
+	{
+		return false;
+	}
+
+	int32 NumAllocations;
+	int32 NumFound = 0;
+	{
+		FScopedAllocationCounter AllocationCounter;
+		for (int32 Query = 0; Query < 100; Query++)
+		{
+			// Every query runs in a new frame, so none of them is served from the candidate cache.
+			GFrameCounter++;
+			TargetingSystem->GatherTargetablePoints(Filters, Found);
+			TargetingSystem->GatherTargetablePoints(Filters, Candidates);
+			NumFound += Found.Num() + Candidates.Num();
+
+			UTargetPointComponent* Nearest = TargetingSystem->FindNearestTarget(Filters);
+			UTargetPointComponent* Next = TargetingSystem->FindNextTarget(Nearest, Filters, Query % 2 == 0);
+			UTargetPointComponent* InDirection = TargetingSystem->FindTargetInDirection(Next, Filters, FVector2D(0.0, 1.0));
+			NumFound += (Nearest != nullptr) + (Next != nullptr) + (InDirection != nullptr);
+		}
+		NumAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	TestTrue(TEXT("The queries found TargetPoints"), NumFound > 0);
+	TestEqual(TEXT("Heap allocations made by steady state targeting queries"), NumAllocations, 0);
+	return true;
+}
+
+#endif
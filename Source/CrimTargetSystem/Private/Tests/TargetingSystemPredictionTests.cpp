@@ -0,0 +1,257 @@
+﻿// Copyright Soccertitan 2025
+
+
+#include "TargetingSystemTestWorld.h"
+
+#include "TargetIndicatorWidget.h"
+#include "TargetPointManagerComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Drives a client TargetingSystemComponent's prediction without a server. Receiving mimics the replication system with
+ * REPNOTIFY_Always: the new values are written, the OnRep of every property in the update is called in the given
+ * order, then PostRepNotifies.
+ */
+struct FTargetingSystemComponentTestAccess
+{
+	/** Sets a widget class so targeting doesn't report a missing one. There is no local player, so none is created. */
+	static void SetTestWidgetClass(UTargetingSystemComponent* Component)
+	{
+		Component->TargetWidgetClass = UTargetIndicatorWidget::StaticClass();
+	}
+
+	/** Runs the end of frame request update, which sends the state changed this frame. */
+	static void EndFrame(UTargetingSystemComponent* Component)
+	{
+		Component->UpdateTargetingStateRequest();
+	}
+
+	static uint16 GetTargetPredictionKey(const UTargetingSystemComponent* Component)
+	{
+		return Component->TargetPredictionKey;
+	}
+
+	static bool HasPendingTargetPrediction(const UTargetingSystemComponent* Component)
+	{
+		return Component->HasPendingTargetPrediction();
+	}
+
+	static uint16 GetAcknowledgedTargetPredictionKey(const UTargetingSystemComponent* Component)
+	{
+		return Component->AcknowledgedTargetPredictionKey;
+	}
+
+	/** Resolves a request on the server as if the TargetValidationSubsystem had accepted it. */
+	static bool ResolveAcceptedRequest(UTargetingSystemComponent* Component, UTargetPointComponent* TargetPoint, bool bCameraLocked, uint16 PredictionKey)
+	{
+		FTargetingStateRequest Request;
+		Request.TargetPoint = TargetPoint;
+		Request.bCameraLocked = bCameraLocked;
+		Request.PredictionKey = PredictionKey;
+		return Component->ResolveTargetingStateRequest(Request, true);
+	}
+
+	struct FServerUpdate
+	{
+		TOptional<UTargetPointComponent*> TargetedPoint;
+		TOptional<bool> bCameraLocked;
+		TOptional<uint16> AcknowledgedKey;
+		/** Calls the acknowledgement's OnRep before the state's. */
+		bool bAcknowledgeFirst = false;
+	};
+
+	static void Receive(UTargetingSystemComponent* Component, const FServerUpdate& Update)
+	{
+		auto ReceiveAcknowledgement = [Component, &Update]()
+		{
+			if (Update.AcknowledgedKey.IsSet())
+			{
+				Component->AcknowledgedTargetPredictionKey = Update.AcknowledgedKey.GetValue();
+				Component->OnRep_AcknowledgedTargetPredictionKey();
+			}
+		};
+
+		if (Update.bAcknowledgeFirst)
+		{
+			ReceiveAcknowledgement();
+		}
+		if (Update.TargetedPoint.IsSet())
+		{
+			UTargetPointComponent* OldTargetedPoint = Component->TargetedPoint;
+			Component->TargetedPoint = Update.TargetedPoint.GetValue();
+			Component->OnRep_TargetedPoint(OldTargetedPoint);
+		}
+		if (Update.bCameraLocked.IsSet())
+		{
+			const bool bOldCameraLocked = Component->bCameraLocked;
+			Component->bCameraLocked = Update.bCameraLocked.GetValue();
+			Component->OnRep_CameraLocked(bOldCameraLocked);
+		}
+		if (!Update.bAcknowledgeFirst)
+		{
+			ReceiveAcknowledgement();
+		}
+		Component->PostRepNotifies();
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetingSystemPredictionRoundTripTest, "TargetingSystem.Prediction.RoundTrips",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetingSystemPredictionRoundTripTest::RunTest(const FString& Parameters)
+{
+	using FAccess = FTargetingSystemComponentTestAccess;
+
+	FTargetingSystemTestWorld TestWorld;
+	UTargetingSystemComponent* Client = TestWorld.SpawnTargetingPawn(FVector::ZeroVector, ROLE_AutonomousProxy);
+	FAccess::SetTestWidgetClass(Client);
+	UTargetPointComponent* TargetA = TestWorld.SpawnTargetPoint(FVector(500.0, 0.0, 0.0));
+	UTargetPointComponent* TargetB = TestWorld.SpawnTargetPoint(FVector(0.0, 500.0, 0.0));
+
+	// An accepted target stays, whichever order the acknowledgement and the state arrive in.
+	Client->SetTarget(TargetA);
+	FAccess::EndFrame(Client);
+	TestTrue(TEXT("The owning client predicts its target"), FAccess::HasPendingTargetPrediction(Client));
+	FAccess::Receive(Client, { TargetA, {}, FAccess::GetTargetPredictionKey(Client), true });
+	TestEqual(TEXT("An accepted target is kept"), Client->GetTargetedPoint(), TargetA);
+	TestFalse(TEXT("The acknowledgement ends the prediction"), FAccess::HasPendingTargetPrediction(Client));
+
+	Client->SetTarget(TargetB);
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { TargetB, {}, FAccess::GetTargetPredictionKey(Client), false });
+	TestEqual(TEXT("An accepted switch is kept"), Client->GetTargetedPoint(), TargetB);
+
+	// A rejected switch rolls back to the server's target. The server's state didn't change, so only the
+	// acknowledgement is received.
+	Client->SetTarget(TargetA);
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { {}, {}, FAccess::GetTargetPredictionKey(Client), false });
+	TestEqual(TEXT("A rejected target rolls back"), Client->GetTargetedPoint(), TargetB);
+	TestFalse(TEXT("The rejection ends the prediction"), FAccess::HasPendingTargetPrediction(Client));
+
+	// State from before the latest request doesn't overwrite the prediction.
+	Client->ClearTarget();
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { TargetA, {}, {}, false });
+	TestNull(TEXT("Stale state keeps the prediction"), Client->GetTargetedPoint());
+	FAccess::Receive(Client, { nullptr, {}, FAccess::GetTargetPredictionKey(Client), false });
+	TestNull(TEXT("An accepted clear is kept"), Client->GetTargetedPoint());
+
+	// Simulated proxies don't predict and only apply what the server sends.
+	UTargetingSystemComponent* Proxy = TestWorld.SpawnTargetingPawn(FVector(0.0, -500.0, 0.0), ROLE_SimulatedProxy);
+	FAccess::SetTestWidgetClass(Proxy);
+	Proxy->SetTarget(TargetA);
+	FAccess::EndFrame(Proxy);
+	TestNull(TEXT("A simulated proxy doesn't change its own target"), Proxy->GetTargetedPoint());
+	TestFalse(TEXT("A simulated proxy never waits for an acknowledgement"), FAccess::HasPendingTargetPrediction(Proxy));
+	FAccess::Receive(Proxy, { TargetA, {}, {}, false });
+	TestEqual(TEXT("A simulated proxy applies the replicated target"), Proxy->GetTargetedPoint(), TargetA);
+	Proxy->ClearTarget();
+	TestEqual(TEXT("A simulated proxy doesn't clear its own target"), Proxy->GetTargetedPoint(), TargetA);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetingSystemPredictionBatchedRequestTest, "TargetingSystem.Prediction.BatchedRequests",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetingSystemPredictionBatchedRequestTest::RunTest(const FString& Parameters)
+{
+	using FAccess = FTargetingSystemComponentTestAccess;
+
+	FTargetingSystemTestWorld TestWorld;
+	UTargetingSystemComponent* Client = TestWorld.SpawnTargetingPawn(FVector::ZeroVector, ROLE_AutonomousProxy);
+	FAccess::SetTestWidgetClass(Client);
+	UTargetPointComponent* TargetA = TestWorld.SpawnTargetPoint(FVector(500.0, 0.0, 0.0));
+	UTargetPointComponent* TargetB = TestWorld.SpawnTargetPoint(FVector(0.0, 500.0, 0.0));
+
+	// Targeting and locking the camera in one frame is one request, and accepting it keeps both.
+	const uint16 FirstKey = FAccess::GetTargetPredictionKey(Client);
+	Client->SetTarget(TargetA);
+	Client->SetCameraLock(true);
+	FAccess::EndFrame(Client);
+	TestEqual(TEXT("Changes made in one frame share one request"), static_cast<int32>(FAccess::GetTargetPredictionKey(Client)), FirstKey + 1);
+	FAccess::Receive(Client, { TargetA, true, FAccess::GetTargetPredictionKey(Client), true });
+	TestEqual(TEXT("An accepted target and lock keep the target"), Client->GetTargetedPoint(), TargetA);
+	TestTrue(TEXT("An accepted target and lock keep the lock"), Client->IsCameraLocked());
+
+	// A rejected switch keeps the confirmed lock.
+	Client->SetTarget(TargetB);
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { {}, {}, FAccess::GetTargetPredictionKey(Client), false });
+	TestEqual(TEXT("A rejected switch rolls back"), Client->GetTargetedPoint(), TargetA);
+	TestTrue(TEXT("A rejected switch keeps the lock"), Client->IsCameraLocked());
+
+	// Clearing also unlocks the camera, in the same request, and rejecting it restores both.
+	Client->ClearTarget();
+	TestFalse(TEXT("Clearing the target unlocks the camera"), Client->IsCameraLocked());
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { {}, {}, FAccess::GetTargetPredictionKey(Client), true });
+	TestEqual(TEXT("A rejected clear restores the target"), Client->GetTargetedPoint(), TargetA);
+	TestTrue(TEXT("A rejected clear restores the lock"), Client->IsCameraLocked());
+
+	// Unlocking on its own is accepted with only the lock replicating.
+	Client->SetCameraLock(false);
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { {}, false, FAccess::GetTargetPredictionKey(Client), false });
+	TestFalse(TEXT("An accepted unlock is kept"), Client->IsCameraLocked());
+	TestEqual(TEXT("An accepted unlock keeps the target"), Client->GetTargetedPoint(), TargetA);
+
+	// Switching and locking again, accepted with the acknowledgement arriving first.
+	Client->SetTarget(TargetB);
+	Client->SetCameraLock(true);
+	FAccess::EndFrame(Client);
+	FAccess::Receive(Client, { TargetB, true, FAccess::GetTargetPredictionKey(Client), true });
+	TestEqual(TEXT("An accepted switch and lock keep the target"), Client->GetTargetedPoint(), TargetB);
+	TestTrue(TEXT("An accepted switch and lock keep the lock"), Client->IsCameraLocked());
+	TestFalse(TEXT("Every request was acknowledged"), FAccess::HasPendingTargetPrediction(Client));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetingSystemPredictionServerRequestTest, "TargetingSystem.Prediction.ServerRequests",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetingSystemPredictionServerRequestTest::RunTest(const FString& Parameters)
+{
+	using FAccess = FTargetingSystemComponentTestAccess;
+
+	FTargetingSystemTestWorld TestWorld;
+	UTargetingSystemComponent* Server = TestWorld.SpawnTargetingPawn(FVector::ZeroVector);
+	FAccess::SetTestWidgetClass(Server);
+	UTargetPointComponent* TargetA = TestWorld.SpawnTargetPoint(FVector(500.0, 0.0, 0.0));
+	UTargetPointComponent* TargetB = TestWorld.SpawnTargetPoint(FVector(0.0, 500.0, 0.0));
+	UTargetPointComponent* TargetC = TestWorld.SpawnTargetPoint(FVector(-500.0, 0.0, 0.0));
+
+	// The manager adds the TargetPoints of its owner when it begins play.
+	UTargetPointManagerComponent* ManagerB = NewObject<UTargetPointManagerComponent>(TargetB->GetOwner());
+	ManagerB->RegisterComponent();
+
+	TestTrue(TEXT("A target and lock request is applied"), FAccess::ResolveAcceptedRequest(Server, TargetA, true, 1));
+	TestEqual(TEXT("An applied request sets the target"), Server->GetTargetedPoint(), TargetA);
+	TestTrue(TEXT("An applied request sets the lock"), Server->IsCameraLocked());
+
+	// The TargetPoint stopped being targetable while the request was queued. The server keeps its state.
+	ManagerB->SetTargetPointEnabled(TargetB, false);
+	Server->SetCameraLock(false);
+	TestFalse(TEXT("A request for an untargetable TargetPoint is rejected"), FAccess::ResolveAcceptedRequest(Server, TargetB, true, 2));
+	TestEqual(TEXT("A rejected request keeps the target"), Server->GetTargetedPoint(), TargetA);
+	TestFalse(TEXT("A rejected request doesn't apply the lock"), Server->IsCameraLocked());
+	TestEqual(TEXT("A rejected request is acknowledged"), static_cast<int32>(FAccess::GetAcknowledgedTargetPredictionKey(Server)), 2);
+
+	// The TargetPoint was destroyed while the request was queued. The target is cleared and the camera stays unlocked.
+	TargetC->GetOwner()->Destroy();
+	TestFalse(TEXT("A request for a destroyed TargetPoint is rejected"), FAccess::ResolveAcceptedRequest(Server, TargetC, true, 3));
+	TestNull(TEXT("A destroyed TargetPoint isn't targeted"), Server->GetTargetedPoint());
+	TestFalse(TEXT("The camera isn't locked without a target"), Server->IsCameraLocked());
+	TestEqual(TEXT("A rejected request is acknowledged"), static_cast<int32>(FAccess::GetAcknowledgedTargetPredictionKey(Server)), 3);
+
+	TestFalse(TEXT("Locking without a target is rejected"), FAccess::ResolveAcceptedRequest(Server, nullptr, true, 4));
+	TestFalse(TEXT("The camera isn't locked without a target"), Server->IsCameraLocked());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,72 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TargetPointComponent.h"
+#include "TargetingSystemComponent.h"
+#include "Camera/CameraComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** A game world that has begun play, for automation tests that need TargetPoints and TargetingSystemComponents. */
+struct FTargetingSystemTestWorld
+{
+	UWorld* World = nullptr;
+
+	FTargetingSystemTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FTargetingSystemTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	/**
+	 * Spawns a pawn with a camera and a TargetingSystemComponent that has begun play.
+	 * @param Role The pawn's local role, to act as the owning client (autonomous proxy) or a simulated proxy.
+	 */
+	UTargetingSystemComponent* SpawnTargetingPawn(const FVector& Location, ENetRole Role = ROLE_Authority) const
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		APawn* Pawn = World->SpawnActor<APawn>(SpawnParameters);
+		Pawn->SetRole(Role);
+
+		UCameraComponent* Camera = NewObject<UCameraComponent>(Pawn);
+		Camera->SetRelativeLocation(Location);
+		Pawn->SetRootComponent(Camera);
+		Camera->RegisterComponent();
+
+		UTargetingSystemComponent* TargetingSystem = NewObject<UTargetingSystemComponent>(Pawn);
+		TargetingSystem->RegisterComponent();
+		return TargetingSystem;
+	}
+
+	/** Spawns an actor with a registered TargetPoint at the Location. */
+	UTargetPointComponent* SpawnTargetPoint(const FVector& Location) const
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AActor* Actor = World->SpawnActor<AActor>(SpawnParameters);
+
+		UTargetPointComponent* TargetPoint = NewObject<UTargetPointComponent>(Actor);
+		TargetPoint->SetRelativeLocation(Location);
+		Actor->SetRootComponent(TargetPoint);
+		TargetPoint->RegisterComponent();
+		return TargetPoint;
+	}
+};
+
+#endif
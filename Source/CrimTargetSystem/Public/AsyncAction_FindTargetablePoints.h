@@ -0,0 +1,47 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AsyncAction_FindTargetablePoints.generated.h"
+
+class UTargetPointComponent;
+class UTargetPointFilterBase;
+class UTargetingSystemComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFindTargetablePointsAsyncSignature, const TArray<UTargetPointComponent*>&, TargetPoints);
+
+/**
+ * Latent version of GetTargetablePoints that also removes the TargetPoints not in line of sight. The traces run
+ * asynchronously, so the result arrives on a later frame without stalling the game thread.
+ */
+UCLASS()
+class TARGETINGSYSTEM_API UAsyncAction_FindTargetablePoints : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Finds all the TargetablePoints within range and in line of sight of the TargetingSystemComponent's owner.
+	 * @param TargetingSystemComponent The component to search from.
+	 * @param Filters The filter to use to find targets.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System", meta = (BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "Filters"))
+	static UAsyncAction_FindTargetablePoints* FindTargetablePointsAsync(UTargetingSystemComponent* TargetingSystemComponent, const TArray<UTargetPointFilterBase*>& Filters);
+
+	/** Called with the TargetPoints found. */
+	UPROPERTY(BlueprintAssignable)
+	FFindTargetablePointsAsyncSignature OnCompleted;
+
+	virtual void Activate() override;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UTargetingSystemComponent> TargetingSystemComponent;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTargetPointFilterBase>> Filters;
+
+	void HandleCompleted(const TArray<UTargetPointComponent*>& TargetPoints);
+};
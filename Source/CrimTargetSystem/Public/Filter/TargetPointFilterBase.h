@@ -7,9 +7,16 @@
 #include "TargetPointFilterBase.generated.h"
 
 class UTargetPointComponent;
+struct FTargetPointCandidateList;
+struct FTargetPointFilterContext;
 
 /**
  * An abstract class for defining which Target Points to filter out.
+ *
+ * Native filters override HasNativePredicate and PassesFilter (or EvaluatePredicate for a batched test) so the
+ * TargetingSystemComponent can test each candidate in place, cheapest filter first, without copying arrays.
+ * Native filters that only override FilterTargetPoints still work, on a copy of the candidates.
+ * Blueprint filters implement the FilterTargetPoints event, which is only called when it is implemented.
  */
 UCLASS(Abstract, Blueprintable, DefaultToInstanced, EditInlineNew)
 class TARGETINGSYSTEM_API UTargetPointFilterBase : public UObject
@@ -17,6 +24,8 @@ class TARGETINGSYSTEM_API UTargetPointFilterBase : public UObject
 	GENERATED_BODY()
 
 public:
+	virtual void PostInitProperties() override;
+
 	/**
 	 * Filters out the passed in TargetPoints given a SourceActor.
 	 * 
@@ -26,6 +35,45 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Targeting System|Filter")
 	virtual void FilterTargetPoints(const AActor* SourceActor, TArray<UTargetPointComponent*>& TargetPoints) const;
 
+	/** Returns true if this filter can test candidates one at a time with PassesFilter/EvaluatePredicate. */
+	virtual bool HasNativePredicate() const { return false; }
+
+	/**
+	 * Tests a single candidate. Only called when HasNativePredicate returns true.
+	 * @return True if the candidate passes the filter and should be kept.
+	 */
+	virtual bool PassesFilter(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, int32 Index) const { return true; }
+
+	/**
+	 * Tests every candidate still passing. The default implementation calls PassesFilter on each of them. Override to
+	 * test all the candidates in one batch.
+	 * @param InOutPass One entry per candidate. Zero means an earlier filter already rejected it. Set to zero to reject.
+	 * @return The number of candidates still passing.
+	 */
+	virtual int32 EvaluatePredicate(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, TArrayView<uint8> InOutPass) const;
+
+	/** Relative cost of running this filter. Cheaper filters run first so expensive ones see fewer candidates. */
+	virtual float GetFilterCost() const;
+
+	/**
+	 * Returns true if ApplyFilters may run this filter out of its declared order, sorted by GetFilterCost.
+	 * By default only native predicates can, as they must be pure: whether a candidate passes may only depend on the
+	 * candidate and the context. Array based and Blueprint filters may depend on, or change, the candidates' order, so
+	 * they always run in their declared place. Override to return false for a predicate that isn't pure.
+	 */
+	virtual bool CanReorder() const;
+
+	/** Returns true if the class implements the Blueprint FilterTargetPoints event. */
+	bool ImplementsBlueprintFilter() const { return bHasBlueprintFilter; }
+
+	/**
+	 * Runs the Filters over the Candidates and stops as soon as no candidate is left. Filters that can be reordered
+	 * run cheapest first between the filters that can't, which keep their declared place.
+	 * Native predicates only mark rejected candidates; the list is compacted once before an array based filter runs
+	 * and once at the end. The order an array based filter leaves the candidates in is kept.
+	 */
+	static void ApplyFilters(const AActor* SourceActor, TConstArrayView<UTargetPointFilterBase*> Filters, FTargetPointCandidateList& Candidates);
+
 protected:
 	/**
 	 * Filters out the passed in TargetPoints given a SourceActor.
@@ -35,5 +83,20 @@ protected:
 	 */
 	UFUNCTION(BlueprintImplementableEvent, Category = "Targeting System|Filter", meta = (DisplayName = "FilterTargetPoints"))
 	void K2_FilterTargetPoints(const AActor* SourceActor, UPARAM(ref) TArray<UTargetPointComponent*>& TargetPoints) const;
-	
+
+private:
+	/**
+	 * Cached when the filter is created, so checking for the Blueprint event never looks up the function. Recompiling
+	 * a Blueprint reinstances its filters, which caches it again.
+	 */
+	uint8 bHasBlueprintFilter : 1;
+
+	/** Calls K2_FilterTargetPoints and counts the invocation in the TargetingSystem stats. */
+	void CallBlueprintFilter(const AActor* SourceActor, TArray<UTargetPointComponent*>& TargetPoints) const;
+
+	/**
+	 * Runs the array based part of the filter over the Candidates: the Blueprint event for filters with a native
+	 * predicate, FilterTargetPoints for the others.
+	 */
+	void FilterCandidatesByArray(const AActor* SourceActor, FTargetPointCandidateList& Candidates) const;
 };
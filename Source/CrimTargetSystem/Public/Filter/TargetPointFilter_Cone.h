@@ -15,7 +15,9 @@ class TARGETINGSYSTEM_API UTargetPointFilter_Cone : public UTargetPointFilterBas
 	GENERATED_BODY()
 
 public:
-	virtual void FilterTargetPoints(const AActor* SourceActor, TArray<UTargetPointComponent*>& TargetPoints) const override;
+	virtual bool HasNativePredicate() const override { return true; }
+	virtual bool PassesFilter(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, int32 Index) const override;
+	virtual int32 EvaluatePredicate(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, TArrayView<uint8> InOutPass) const override;
 
 	// The half angle of the cone. Will be doubled for the full angle of the cone.
 	UPROPERTY(EditAnywhere, meta = (ClampMin = 0, ClampMax = 180))
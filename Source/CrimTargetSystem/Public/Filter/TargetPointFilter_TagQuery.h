@@ -0,0 +1,33 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "TargetPointFilterBase.h"
+#include "TargetPointFilter_TagQuery.generated.h"
+
+class UTargetPointSubsystem;
+
+/**
+ * Filters out targets whose TargetPointTag doesn't match the TagQuery. Parent tags match, so a query for
+ * TargetPoint.WeakSpot keeps TargetPoint.WeakSpot.Head.
+ */
+UCLASS()
+class TARGETINGSYSTEM_API UTargetPointFilter_TagQuery : public UTargetPointFilterBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool HasNativePredicate() const override { return true; }
+	virtual bool PassesFilter(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, int32 Index) const override;
+	virtual int32 EvaluatePredicate(const FTargetPointFilterContext& Context, const FTargetPointCandidateList& Candidates, TArrayView<uint8> InOutPass) const override;
+
+	// The query the TargetPointTag has to match.
+	UPROPERTY(EditAnywhere)
+	FGameplayTagQuery TagQuery;
+
+private:
+	bool MatchesTag(const FGameplayTag& Tag) const;
+	FGameplayTag GetCandidateTag(const UTargetPointSubsystem* Subsystem, const FTargetPointCandidateList& Candidates, int32 Index) const;
+};
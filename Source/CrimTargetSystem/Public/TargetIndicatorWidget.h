@@ -0,0 +1,51 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "TargetIndicatorWidget.generated.h"
+
+class UCanvasPanel;
+class UTargetPointComponent;
+
+/**
+ * Full screen widget that draws a marker over each of its TargetPoints. All the TargetPoints are projected with one
+ * view projection per frame, and the marker widgets are pooled, so indicating many TargetPoints doesn't need a
+ * WidgetComponent each.
+ */
+UCLASS(Blueprintable)
+class TARGETINGSYSTEM_API UTargetIndicatorWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Sets the TargetPoints to draw a marker over. The markers follow the TargetPoints until this is called again. */
+	void SetTargetPoints(TConstArrayView<UTargetPointComponent*> InTargetPoints);
+
+protected:
+	/** The widget drawn over each TargetPoint. */
+	UPROPERTY(EditAnywhere, Category = "Targeting System")
+	TSubclassOf<UUserWidget> MarkerWidgetClass;
+
+	/** The point of the marker placed over the TargetPoint. (0.5, 0.5) centers the marker. */
+	UPROPERTY(EditAnywhere, Category = "Targeting System")
+	FVector2D MarkerAlignment = FVector2D(0.5f, 0.5f);
+
+	virtual void NativeOnInitialized() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+private:
+	/** The canvas the markers are placed on. Created if the widget tree has no root. */
+	UPROPERTY(Transient)
+	TObjectPtr<UCanvasPanel> Canvas;
+
+	/** Every marker created so far. Markers past the number of TargetPoints are collapsed and kept for reuse. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UUserWidget>> Markers;
+
+	TArray<TWeakObjectPtr<UTargetPointComponent>> TargetPoints;
+
+	/** Returns the pooled marker at Index, creating it if the pool is too small. */
+	UUserWidget* GetOrCreateMarker(int32 Index);
+};
@@ -0,0 +1,76 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TargetLineOfSightSubsystem.generated.h"
+
+class UTargetPointComponent;
+
+/**
+ * Keeps the line of sight between Source actors and TargetPoints up to date for every TargetingSystemComponent in the
+ * world. Identical Source/TargetPoint pairs share one entry, and only a fixed number of entries are traced each frame
+ * (LineOfSightTracesPerFrame in the settings), oldest first. The cost stays flat no matter how many components are
+ * locked on; the results just get older.
+ */
+UCLASS()
+class TARGETINGSYSTEM_API UTargetLineOfSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the WorldContextObject's world. Can be null for unsupported world types. */
+	static UTargetLineOfSightSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Starts keeping the line of sight between the Source and the TargetPoint up to date. Calls are reference counted,
+	 * every AddWatch needs a matching RemoveWatch.
+	 */
+	void AddWatch(AActor* Source, UTargetPointComponent* TargetPoint);
+	void RemoveWatch(const AActor* Source, const UTargetPointComponent* TargetPoint);
+
+	/**
+	 * Gets the last traced line of sight between the Source and the TargetPoint.
+	 * @param bOutVisible Set to true if nothing blocked the last trace.
+	 * @return False if the pair is not watched or has not been traced yet.
+	 */
+	bool GetLineOfSight(const AActor* Source, const UTargetPointComponent* TargetPoint, bool& bOutVisible) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FWatchKey = TPair<FObjectKey, FObjectKey>;
+
+	struct FWatch
+	{
+		FWatchKey Key;
+		TWeakObjectPtr<AActor> Source;
+		TWeakObjectPtr<UTargetPointComponent> TargetPoint;
+		int32 RefCount = 0;
+		/** The TickCount of the tick that last traced the watch. */
+		uint32 TracedTick = 0;
+		bool bHasResult = false;
+		bool bVisible = false;
+	};
+
+	TArray<FWatch> Watches;
+	TMap<FWatchKey, int32> WatchIndices;
+
+	/** Watches that have never been traced. They are traced before refreshing older results. */
+	TArray<FWatchKey> NewWatches;
+
+	/** Where the round robin over Watches continues next frame. */
+	int32 NextWatchIndex = 0;
+
+	/** Counts the ticks, starting at 1, so a watch is traced at most once per tick. */
+	uint32 TickCount = 0;
+
+	void TraceWatch(FWatch& Watch) const;
+};
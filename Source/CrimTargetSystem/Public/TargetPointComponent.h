@@ -20,6 +20,7 @@ class TARGETINGSYSTEM_API UTargetPointComponent : public USphereComponent
 
 	friend UTargetPointManagerComponent;
 	friend struct FTargetPointContainer;
+	friend class UTargetPointSubsystem;
 
 public:
 	UTargetPointComponent();
@@ -30,6 +31,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Targeting System|Target Point")
 	bool GetIsTargetable() const {return bTargetable;}
 
+	//----------------------------------------------------------------------------------------------------------------
+	// Component Overrides.
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+	//----------------------------------------------------------------------------------------------------------------
+
 private:
 	UPROPERTY(EditDefaultsOnly)
 	FGameplayTag TargetPointTag;
@@ -38,4 +46,22 @@ private:
 	bool bTargetable = true;
 
 	void SetIsTargetable(const bool bEnabled);
+
+	/** Index into the TargetPointSubsystem's registry. INDEX_NONE when not registered. */
+	int32 RegistryIndex = INDEX_NONE;
+
+	/**
+	 * The TargetPointManagerComponent managing this TargetPoint. Set on the authority, and on clients for the
+	 * TargetPoints in a compact replication layout, which clients build themselves.
+	 */
+	TWeakObjectPtr<UTargetPointManagerComponent> Manager;
+
+	/** Index into the Manager's items. INDEX_NONE when not managed. */
+	int32 ManagerItemIndex = INDEX_NONE;
+
+	/**
+	 * Adds this TargetPoint to its owner's TargetPointManagerComponent if the manager has already begun play. On clients
+	 * only gives a compact layout TargetPoint its slot back.
+	 */
+	void AddToOwnerManager();
 };
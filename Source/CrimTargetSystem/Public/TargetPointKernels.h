@@ -0,0 +1,92 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Batch math over structure-of-arrays locations (see FTargetPointCandidateList). Each kernel has a scalar reference
+ * implementation and a vectorized implementation. The dispatching version picks one based on the
+ * TargetingSystem.VectorizedKernels console variable.
+ */
+namespace TargetPointKernels
+{
+	/**
+	 * Finds the location closest to Origin.
+	 * @param OutDistanceSquared The squared distance to the closest location.
+	 * @return The index of the closest location. INDEX_NONE if Num is 0. Ties resolve to the lowest index.
+	 */
+	TARGETINGSYSTEM_API int32 FindNearest(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, float& OutDistanceSquared);
+	TARGETINGSYSTEM_API int32 FindNearestScalar(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, float& OutDistanceSquared);
+	TARGETINGSYSTEM_API int32 FindNearestVectorized(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, float& OutDistanceSquared);
+
+	/**
+	 * Tests which locations are inside the cone.
+	 * @param Direction The normalized direction of the cone.
+	 * @param CosHalfAngle The cosine of the cone's half angle.
+	 * @param OutInCone Set to 1 for every location inside the cone, 0 otherwise. Must hold Num entries.
+	 */
+	TARGETINGSYSTEM_API void ConeTest(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle, uint8* OutInCone);
+	TARGETINGSYSTEM_API void ConeTestScalar(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle, uint8* OutInCone);
+	TARGETINGSYSTEM_API void ConeTestVectorized(const float* X, const float* Y, const float* Z, int32 Num, const FVector3f& Origin, const FVector3f& Direction, float CosHalfAngle, uint8* OutInCone);
+
+	/**
+	 * Monotonic replacement for the signed angle from Reference to Offset. Ranges from -2 to 2 like -180 to 180
+	 * degrees, with the sign of the cross product. Neither vector needs to be normalized.
+	 * Returns 0 when the vectors are parallel, like the signed angle it replaces.
+	 */
+	FORCEINLINE float PseudoAngle(float Cross, float Dot)
+	{
+		const float Denominator = FMath::Abs(Cross) + FMath::Abs(Dot);
+		if (Cross == 0.f || Denominator <= 0.f)
+		{
+			return 0.f;
+		}
+		const float Unsigned = 1.f - Dot / Denominator;
+		return Cross > 0.f ? Unsigned : -Unsigned;
+	}
+
+	/**
+	 * Finds the next location around Origin, on the horizontal plane, when cycling right or left from Reference.
+	 * Picks the closest location in the search direction, wrapping around to the furthest location on the other side
+	 * when there is nothing in the search direction.
+	 * @param Origin The location to rotate around, usually the camera.
+	 * @param Reference The direction from the Origin to the current target.
+	 * @param bSearchLeft If true, cycles left. False cycles right.
+	 * @return The index of the next location. INDEX_NONE if no location qualifies.
+	 */
+	TARGETINGSYSTEM_API int32 FindNextAround(const float* X, const float* Y, int32 Num, const FVector2f& Origin, const FVector2f& Reference, bool bSearchLeft);
+
+	/** The camera basis used to place locations on screen without a full projection. */
+	struct FViewBasis
+	{
+		FVector3f Origin;
+		FVector3f Forward;
+		FVector3f Right;
+		FVector3f Up;
+
+		/** Returns false if the Location is behind the view. */
+		bool ToScreen(const FVector3f& Location, FVector2f& OutScreen) const
+		{
+			const FVector3f Offset = Location - Origin;
+			const float Depth = Offset | Forward;
+			if (Depth <= UE_KINDA_SMALL_NUMBER)
+			{
+				return false;
+			}
+			const float InvDepth = 1.f / Depth;
+			OutScreen = FVector2f((Offset | Right) * InvDepth, (Offset | Up) * InvDepth);
+			return true;
+		}
+	};
+
+	/**
+	 * Finds the location closest to From on screen that lies in the Direction, e.g. the direction a gamepad stick is
+	 * pushed. Locations behind the view are ignored.
+	 * @param From The screen position to search from, as returned by FViewBasis::ToScreen.
+	 * @param Direction The screen direction to search in. X is right, Y is up. Doesn't need to be normalized.
+	 * @param CosHalfAngle The cosine of the widest angle from Direction a location can be at.
+	 * @return The index of the location found. INDEX_NONE if no location qualifies.
+	 */
+	TARGETINGSYSTEM_API int32 FindNearestInDirection(const float* X, const float* Y, const float* Z, int32 Num, const FViewBasis& View, const FVector2f& From, const FVector2f& Direction, float CosHalfAngle);
+}
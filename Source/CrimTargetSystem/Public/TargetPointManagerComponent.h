@@ -11,9 +11,12 @@
 
 class UTargetPointComponent;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTargetPointManagerTargetabilitySignature, UTargetPointComponent*, TargetPoint, bool, bTargetable);
+
 /**
  *	An actor with this component can manage their TargetPointComponents. On BeginPlay it will search the
- *	OwningActor for existing TargetPointComponents and add them to the manager.
+ *	OwningActor for existing TargetPointComponents and add them to the manager. TargetPointComponents registered
+ *	afterwards are added when they register and removed when they unregister.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class TARGETINGSYSTEM_API UTargetPointManagerComponent : public UActorComponent
@@ -23,6 +26,20 @@ class TARGETINGSYSTEM_API UTargetPointManagerComponent : public UActorComponent
 public:
 	UTargetPointManagerComponent();
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/**
+	 * Adds the TargetPoint to the manager. TargetPoints of the owner are added automatically, only call this for
+	 * TargetPoints owned by another actor. Does nothing if the TargetPoint is already managed.
+	 * With compact replication, a layout TargetPoint that is added again gets its slot back. The targetability of
+	 * other TargetPoints added after BeginPlay is not replicated.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Target Point")
+	void AddTargetPoint(UTargetPointComponent* TargetPoint);
+
+	/** Removes the TargetPoint from the manager. Its targetability is left as it is. */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Target Point")
+	void RemoveTargetPoint(UTargetPointComponent* TargetPoint);
 
 	/** Enables/Disables the specified TargetPointComponent for targeting. */
 	UFUNCTION(BlueprintCallable, Category = "Targeting System|Target Point")
@@ -32,12 +49,87 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Targeting System|Target Point")
 	void SetTargetPointEnabledByTag(const FGameplayTag& Type, bool bEnabled);
 
+	/**
+	 * Called when one of the managed TargetPoints is enabled or disabled. Called on the server when the change is made
+	 * and on clients when it is replicated.
+	 */
+	UPROPERTY(BlueprintAssignable, DisplayName = "OnTargetabilityChanged")
+	FTargetPointManagerTargetabilitySignature OnTargetabilityChangedDelegate;
+
+	/**
+	 * Replicates only one targetable bit per TargetPoint instead of the full item list. The server and clients each
+	 * build the same layout on BeginPlay from the owner's TargetPointComponents, sorted by name, so the tags and
+	 * components never have to be sent. Only TargetPoints with names that are stable for networking (added in the
+	 * actor's defaults or construction script) are part of the layout.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Replication")
+	bool bCompactReplication = false;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void OnRegister() override;
 
 private:
+	friend FTargetPointContainer;
+	friend UTargetPointComponent;
+
+	/** Replicated instead of the items of the TargetPointList when using compact replication. */
+	UPROPERTY(ReplicatedUsing = OnRep_TargetableMask)
+	FTargetPointTargetableMask TargetableMask;
+
 	UPROPERTY(Replicated)
 	FTargetPointContainer TargetPointList;
+
+	/** The number of items at the start of the TargetPointList that are part of the compact replication layout. */
+	int32 NumLayoutItems = 0;
+
+	/** The names of the layout's TargetPoints, in layout order. Finds the slot of a TargetPoint that is added again. */
+	TArray<FName> LayoutNames;
+
+	/**
+	 * The indices into TargetPointList.Items of the Items with each tag. An Item is indexed under its TargetPointTag and
+	 * all of its parents, so looking up a tag finds every Item the tag matches.
+	 */
+	TMultiMap<FGameplayTag, int32> TagToItemIndices;
+
+	/**
+	 * Applies the Item's targetability to its TargetPointComponent, which updates the TargetPointSubsystem and the
+	 * TargetingSystemComponents locked onto it, then broadcasts OnTargetabilityChanged. Does nothing if it didn't change.
+	 */
+	void ApplyTargetability(const FTargetPointItem& Item);
+	
+	UFUNCTION()
+	void OnRep_TargetableMask();
+
+	/** Applies the TargetableMask to the items in the layout. */
+	void ApplyTargetableMask();
+
+	/** Sets the Item's targetability, marks it for replication and applies it. */
+	void SetItemTargetable(int32 Index, bool bEnabled);
+
+	/** Adds an item for the TargetPoint and gives the TargetPoint its handle. Returns the item's index. */
+	int32 AddItem(UTargetPointComponent* TargetPoint);
+
+	/**
+	 * Builds the compact replication layout. Called on BeginPlay on the server and clients, so the layout
+	 * TargetPoints get their handles on clients too. Clients only use them to keep the layout's slots when a
+	 * TargetPoint is removed; changing targetability stays server only.
+	 * The layout is every TargetPoint of the owner with a name stable for networking, sorted by name, so it is the
+	 * same on the server and clients whatever was registered first.
+	 */
+	void InitializeLayout();
+
+	/**
+	 * Gives the TargetPoint its empty layout slot back if it was part of the layout. Called on the server and on
+	 * clients when a layout TargetPoint registers again. Returns false if the TargetPoint has no free slot.
+	 */
+	bool RestoreLayoutItem(UTargetPointComponent* TargetPoint);
+
+	/** Adds the Item at the Index to TagToItemIndices. */
+	void IndexItemTags(int32 Index);
+
+	/** Removes the Item at the Index from TagToItemIndices. */
+	void UnindexItemTags(int32 Index);
 	
 	/** Called on BeginPlay to add TargetPoints to the manager. */
 	void InitializeTargetPoints();
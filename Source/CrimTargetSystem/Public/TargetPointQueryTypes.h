@@ -0,0 +1,144 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UTargetPointComponent;
+
+enum class ETargetPointFlags : uint8
+{
+	None = 0,
+	/** The TargetPoint can currently be targeted. */
+	Targetable = 1 << 0,
+};
+ENUM_CLASS_FLAGS(ETargetPointFlags);
+
+/**
+ * Packed structure-of-arrays copy of the registered TargetPoints, indexed by each TargetPoint's RegistryIndex.
+ * Lets queries read locations and state without dereferencing the components.
+ * Locations are stored as float, which keeps 1 cm precision or better up to about 80 km from the world origin and
+ * halves with every doubling of the distance beyond that. Larger worlds should rebase the world origin around the
+ * players to keep targeting precise.
+ */
+struct TARGETINGSYSTEM_API FTargetPointSnapshot
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	TArray<ETargetPointFlags> Flags;
+	/** Index into the owning TargetPointSubsystem's tag table. */
+	TArray<int32> TagIndex;
+
+	int32 Num() const { return X.Num(); }
+
+	int32 Add(const FVector& Location, ETargetPointFlags InFlags, int32 InTagIndex)
+	{
+		X.Add(Location.X);
+		Y.Add(Location.Y);
+		Z.Add(Location.Z);
+		Flags.Add(InFlags);
+		return TagIndex.Add(InTagIndex);
+	}
+
+	void RemoveAtSwap(int32 Index)
+	{
+		X.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Y.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Z.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		TagIndex.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+
+	void SetLocation(int32 Index, const FVector& Location)
+	{
+		X[Index] = Location.X;
+		Y[Index] = Location.Y;
+		Z[Index] = Location.Z;
+	}
+
+	FVector GetLocation(int32 Index) const
+	{
+		return FVector(X[Index], Y[Index], Z[Index]);
+	}
+
+	void Reset()
+	{
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+		Flags.Reset();
+		TagIndex.Reset();
+	}
+};
+
+/**
+ * Structure-of-arrays list of TargetPoints gathered by a targeting query. The locations are copied from the
+ * FTargetPointSnapshot so filters and selection kernels can run over contiguous memory, with the same float precision.
+ * Storage is inline up to InlineCapacity candidates, so a list declared on the stack doesn't touch the heap for
+ * typical queries.
+ */
+struct TARGETINGSYSTEM_API FTargetPointCandidateList
+{
+	static constexpr int32 InlineCapacity = 64;
+
+	template <typename ElementType>
+	using TCandidateArray = TArray<ElementType, TInlineAllocator<InlineCapacity>>;
+
+	TCandidateArray<UTargetPointComponent*> Points;
+	TCandidateArray<float> X;
+	TCandidateArray<float> Y;
+	TCandidateArray<float> Z;
+	/** Index into the TargetPointSubsystem's tag table. */
+	TCandidateArray<int32> TagIndex;
+
+	int32 Num() const { return Points.Num(); }
+	bool IsEmpty() const { return Points.IsEmpty(); }
+
+	void Add(UTargetPointComponent* Point, float InX, float InY, float InZ, int32 InTagIndex)
+	{
+		Points.Add(Point);
+		X.Add(InX);
+		Y.Add(InY);
+		Z.Add(InZ);
+		TagIndex.Add(InTagIndex);
+	}
+
+	FVector GetLocation(int32 Index) const
+	{
+		return FVector(X[Index], Y[Index], Z[Index]);
+	}
+
+	void Reset()
+	{
+		Points.Reset();
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+		TagIndex.Reset();
+	}
+
+	/** Removes every candidate whose entry in Keep is zero. Preserves the order of the remaining candidates. */
+	void Compact(TConstArrayView<uint8> Keep);
+
+	/**
+	 * Makes the list match TargetPoints, in their order. Used to apply the result of an array based filter, which may
+	 * remove, reorder or add TargetPoints. Added TargetPoints read their locations from the components.
+	 */
+	void AssignPoints(TConstArrayView<UTargetPointComponent*> TargetPoints);
+
+	/** Adds the TargetPoints, reading their locations from the components. Invalid TargetPoints are skipped. */
+	void AppendPoints(TConstArrayView<UTargetPointComponent*> TargetPoints);
+};
+
+/** Values shared by every filter while filtering one set of candidates. Computed once per query. */
+struct TARGETINGSYSTEM_API FTargetPointFilterContext
+{
+	explicit FTargetPointFilterContext(const AActor* InSourceActor);
+
+	/** The actor the candidates are filtered against. */
+	const AActor* SourceActor = nullptr;
+	FVector3f SourceLocation = FVector3f::ZeroVector;
+	FVector3f SourceForward = FVector3f::ForwardVector;
+};
@@ -0,0 +1,125 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform hash grid of TargetPoint indices bucketed by location. Range queries only visit the cells overlapping the
+ * query's bounding box, which is at most 27 cells when the radius is no larger than the cell size, and never more
+ * than the occupied cells.
+ */
+class TARGETINGSYSTEM_API FTargetPointSpatialHash
+{
+public:
+	FTargetPointSpatialHash()
+	{
+		SetCellSize(2000.0);
+	}
+
+	/** Sets the size of each cell. Only call this while the grid is empty. */
+	void SetCellSize(double InCellSize)
+	{
+		check(Cells.IsEmpty());
+		CellSize = FMath::Max(InCellSize, 1.0);
+		InvCellSize = 1.0 / CellSize;
+	}
+
+	double GetCellSize() const { return CellSize; }
+
+	/** Returns the cell that contains the Location. */
+	FIntVector GetCell(const FVector& Location) const
+	{
+		return FIntVector(
+			FMath::FloorToInt32(Location.X * InvCellSize),
+			FMath::FloorToInt32(Location.Y * InvCellSize),
+			FMath::FloorToInt32(Location.Z * InvCellSize));
+	}
+
+	void Add(int32 Index, const FIntVector& Cell);
+	void Remove(int32 Index, const FIntVector& Cell);
+
+	/** Moves the Index from one cell to another. */
+	void Move(int32 Index, const FIntVector& OldCell, const FIntVector& NewCell);
+
+	/** Renames OldIndex to NewIndex inside the Cell. Used when the owner of the indices swap-removes an element. */
+	void Reindex(int32 OldIndex, int32 NewIndex, const FIntVector& Cell);
+
+	void Reset()
+	{
+		Cells.Reset();
+	}
+
+	/**
+	 * Calls Func(int32 Index) for every index in the cells overlapping the sphere. Callers still need to do the exact
+	 * distance check, as cells can contain indices outside the Radius.
+	 * When the sphere overlaps more cells than are occupied, the occupied cells are walked instead of probing every
+	 * overlapped cell, so a radius far larger than the cell size costs no more than a scan of the grid.
+	 */
+	template<typename FuncType>
+	void ForEachInRange(const FVector& Origin, double Radius, FuncType&& Func) const
+	{
+		if (Cells.IsEmpty())
+		{
+			return;
+		}
+
+		const FVector MinCellLocation = FloorVector((Origin - FVector(Radius)) * InvCellSize);
+		const FVector MaxCellLocation = FloorVector((Origin + FVector(Radius)) * InvCellSize);
+		const FVector CellExtent = MaxCellLocation - MinCellLocation + FVector(1.0);
+		const double NumOverlappedCells = CellExtent.X * CellExtent.Y * CellExtent.Z;
+
+		if (NumOverlappedCells > Cells.Num())
+		{
+			for (const TPair<FIntVector, TArray<int32>>& Pair : Cells)
+			{
+				const FIntVector& Cell = Pair.Key;
+				if (Cell.X >= MinCellLocation.X && Cell.X <= MaxCellLocation.X &&
+					Cell.Y >= MinCellLocation.Y && Cell.Y <= MaxCellLocation.Y &&
+					Cell.Z >= MinCellLocation.Z && Cell.Z <= MaxCellLocation.Z)
+				{
+					for (const int32 Index : Pair.Value)
+					{
+						Func(Index);
+					}
+				}
+			}
+			return;
+		}
+
+		// Cells come from world locations, so the bounds fit in int32 here.
+		const FIntVector MinCell(static_cast<int32>(MinCellLocation.X), static_cast<int32>(MinCellLocation.Y), static_cast<int32>(MinCellLocation.Z));
+		const FIntVector MaxCell(static_cast<int32>(MaxCellLocation.X), static_cast<int32>(MaxCellLocation.Y), static_cast<int32>(MaxCellLocation.Z));
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					if (const TArray<int32>* Indices = Cells.Find(FIntVector(X, Y, Z)))
+					{
+						for (const int32 Index : *Indices)
+						{
+							Func(Index);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/** Returns the number of occupied cells. */
+	int32 GetNumCells() const { return Cells.Num(); }
+
+private:
+	static FVector FloorVector(const FVector& Vector)
+	{
+		return FVector(FMath::FloorToDouble(Vector.X), FMath::FloorToDouble(Vector.Y), FMath::FloorToDouble(Vector.Z));
+	}
+
+	double CellSize = 0.0;
+	double InvCellSize = 0.0;
+
+	TMap<FIntVector, TArray<int32>> Cells;
+};
@@ -0,0 +1,131 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "TargetPointQueryTypes.h"
+#include "TargetPointSpatialHash.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TargetPointSubsystem.generated.h"
+
+class UTargetPointComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FTargetPointSubsystemTargetPointDelegate, UTargetPointComponent* /*TargetPoint*/);
+
+/**
+ * Keeps track of every registered TargetPointComponent in the world. TargetPointComponents add themselves on
+ * OnRegister and remove themselves on OnUnregister, so targeting queries can gather candidates without going
+ * through the physics scene. TargetPoints are bucketed in a spatial hash grid so range queries only visit nearby cells,
+ * and their locations and state are mirrored into a packed FTargetPointSnapshot so queries never chase component
+ * pointers.
+ */
+UCLASS()
+class TARGETINGSYSTEM_API UTargetPointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the WorldContextObject's world. Can be null for unsupported world types. */
+	static UTargetPointSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Adds the TargetPoint to the registry. Does nothing if it is already registered. */
+	void RegisterTargetPoint(UTargetPointComponent* TargetPoint);
+
+	/** Removes the TargetPoint from the registry. */
+	void UnregisterTargetPoint(UTargetPointComponent* TargetPoint);
+
+	/**
+	 * Updates the TargetPoint's location in the snapshot and re-buckets it if it moved into a different grid cell.
+	 * Called when its transform is updated.
+	 */
+	void UpdateTargetPointLocation(UTargetPointComponent* TargetPoint);
+
+	/** Updates the TargetPoint's flags in the snapshot. Called when its targetability changes. */
+	void UpdateTargetPointFlags(UTargetPointComponent* TargetPoint);
+
+	/**
+	 * Gathers all the registered TargetPoints within range.
+	 * @param Origin The location to search from.
+	 * @param Radius The maximum distance from the Origin.
+	 * @param OutTargetPoints Appended with the TargetPoints found.
+	 */
+	void GetTargetPointsInRange(const FVector& Origin, float Radius, TArray<UTargetPointComponent*>& OutTargetPoints) const;
+
+	/**
+	 * Gathers all the registered TargetPoints within range along with their locations.
+	 * @param Origin The location to search from.
+	 * @param Radius The maximum distance from the Origin.
+	 * @param RequiredFlags Only TargetPoints that have all of these flags are gathered.
+	 * @param OutCandidates Appended with the TargetPoints found.
+	 */
+	void GatherCandidates(const FVector& Origin, float Radius, ETargetPointFlags RequiredFlags, FTargetPointCandidateList& OutCandidates) const;
+
+	/** Returns the packed copy of the registered TargetPoints. */
+	const FTargetPointSnapshot& GetSnapshot() const { return Snapshot; }
+
+	/** Returns the TargetPoint's index into the snapshot. INDEX_NONE if it is not registered. */
+	int32 GetSnapshotIndex(const UTargetPointComponent* TargetPoint) const;
+
+	/**
+	 * Incremented whenever a TargetPoint is registered, unregistered or changes targetability. Cached query results
+	 * are stale once it changes.
+	 */
+	uint32 GetRevision() const { return Revision; }
+
+	/** Broadcast when a registered TargetPoint's targetability changes. */
+	FTargetPointSubsystemTargetPointDelegate OnTargetabilityChanged;
+
+	/** Broadcast when a TargetPoint is unregistered, e.g. because its owner is being destroyed. */
+	FTargetPointSubsystemTargetPointDelegate OnTargetPointUnregistered;
+
+	/**
+	 * Broadcast when a TargetPoint has moved further than the TargetMoveThreshold in the settings since it was last
+	 * broadcast. Smaller movements are not reported.
+	 */
+	FTargetPointSubsystemTargetPointDelegate OnTargetPointMoved;
+
+	/** Returns the index of the Tag in the snapshot's tag table. INDEX_NONE if no registered TargetPoint uses it. */
+	int32 FindTagIndex(const FGameplayTag& Tag) const;
+
+	/** Returns the tag at the index of the snapshot's tag table. */
+	const FGameplayTag& GetTag(int32 TagIndex) const { return Tags[TagIndex]; }
+
+	/** Returns the number of tags in the snapshot's tag table. */
+	int32 GetNumTags() const { return Tags.Num(); }
+
+	/** Returns all the registered TargetPoints. */
+	const TArray<TObjectPtr<UTargetPointComponent>>& GetAllTargetPoints() const { return TargetPoints; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Every registered TargetPoint. A TargetPoint's RegistryIndex is its index into this array. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTargetPointComponent>> TargetPoints;
+
+	/** The grid cell each TargetPoint is bucketed in. Parallel to TargetPoints. */
+	TArray<FIntVector> TargetPointCells;
+
+	/** Where each TargetPoint was when OnTargetPointMoved was last broadcast for it. Parallel to TargetPoints. */
+	TArray<FVector> MovedFromLocations;
+	double MoveThresholdSquared = 0.0;
+
+	FTargetPointSpatialHash SpatialHash;
+
+	/** Packed copy of the TargetPoints' locations and state. Parallel to TargetPoints. */
+	FTargetPointSnapshot Snapshot;
+
+	uint32 Revision = 0;
+
+	/** Every TargetPointTag used by a registered TargetPoint. Referenced by index from the snapshot. */
+	TArray<FGameplayTag> Tags;
+	TMap<FGameplayTag, int32> TagIndices;
+
+	int32 FindOrAddTagIndex(const FGameplayTag& Tag);
+	static ETargetPointFlags GetTargetPointFlags(const UTargetPointComponent* TargetPoint);
+};
@@ -0,0 +1,128 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TargetValidationSubsystem.generated.h"
+
+class UTargetPointComponent;
+class UTargetingSystemComponent;
+struct FTargetingStateRequest;
+
+/**
+ * Validates the targets of every TargetingSystemComponent from a single world tick, replacing per-component timers.
+ *
+ * Targetability and range are checked when something changes: a watched TargetPoint changing targetability, being
+ * unregistered or moving further than the TargetMoveThreshold (reported by the TargetPointSubsystem), or the owner
+ * moving further than the TargetMoveThreshold. Only line of sight is polled. How often depends on the component's
+ * significance: locally controlled players and owners near a player's view at their CheckFrequency, far or dormant
+ * owners rarely. Everything but the locally controlled players shares a time budget (ValidationBudgetMicroseconds in
+ * the settings); whatever doesn't fit is polled first on the next frame.
+ *
+ * On the server it also validates the target requests of the owning clients. Requests are queued, only the latest per
+ * component is kept, and checked once per frame: targetability and range against the TargetPointSubsystem's snapshot,
+ * then line of sight with one async trace per remaining request. Rejected requests are acknowledged without changing
+ * the target, which rolls the client back.
+ */
+UCLASS()
+class TARGETINGSYSTEM_API UTargetValidationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the WorldContextObject's world. Can be null for unsupported world types. */
+	static UTargetValidationSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Starts validating the component's targeted point and locked targets. Call again whenever they change so the
+	 * right TargetPoints are watched.
+	 */
+	void RegisterComponent(UTargetingSystemComponent* Component);
+
+	/** Stops validating the component's targets. */
+	void UnregisterComponent(UTargetingSystemComponent* Component);
+
+	/**
+	 * Queues the owning client's request for a new targeting state. Replaces an older request of the same component.
+	 * Server only.
+	 */
+	void QueueTargetRequest(UTargetingSystemComponent* Component, const FTargetingStateRequest& State);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class ESignificance : uint8
+	{
+		LocalPlayer,
+		Near,
+		Far,
+		Dormant
+	};
+
+	struct FEntry
+	{
+		TWeakObjectPtr<UTargetingSystemComponent> Component;
+		double NextValidationTime = 0.0;
+		/** Where the owner was when the range was last checked. */
+		FVector OwnerLocation = FVector::ZeroVector;
+		/** The TargetPoints the component is targeting or locked onto. */
+		TArray<TObjectKey<UTargetPointComponent>, TInlineAllocator<4>> WatchedPoints;
+	};
+
+	TArray<FEntry> Entries;
+
+	struct FTargetRequest
+	{
+		TWeakObjectPtr<UTargetingSystemComponent> Component;
+		TWeakObjectPtr<UTargetPointComponent> TargetPoint;
+		uint16 PredictionKey = 0;
+		bool bCameraLocked = false;
+		bool bClearTarget = false;
+		/** Set once the request passed the range check and its line of sight is being traced. */
+		FTraceHandle TraceHandle;
+	};
+
+	/** At most one per component. */
+	TArray<FTargetRequest> TargetRequests;
+
+	/** The components watching each TargetPoint. */
+	TMap<TObjectKey<UTargetPointComponent>, TArray<TWeakObjectPtr<UTargetingSystemComponent>, TInlineAllocator<2>>> Watchers;
+
+	double MoveThresholdSquared = 0.0;
+
+	/** Where the round robin over Entries continues next frame. */
+	int32 NextEntryIndex = 0;
+
+	/** The view location of every player this frame. */
+	TArray<FVector, TInlineAllocator<8>> ViewLocations;
+
+	void GatherViewLocations();
+	ESignificance GetSignificance(const UTargetingSystemComponent* Component) const;
+	double GetValidationInterval(ESignificance Significance, const UTargetingSystemComponent* Component) const;
+	void Validate(FEntry& Entry, ESignificance Significance, double Now) const;
+	void CheckRange(FEntry& Entry) const;
+
+	/** Checks the range of the new target requests and starts their line of sight traces. */
+	void ProcessTargetRequests();
+	/** Returns false if the request's TargetPoint is gone, untargetable or out of range. */
+	bool IsTargetRequestInRange(const FTargetRequest& Request) const;
+	void OnTargetRequestTraceComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void ResolveTargetRequest(const FTargetRequest& Request, bool bAccepted) const;
+
+	void AddWatches(FEntry& Entry);
+	void RemoveWatches(FEntry& Entry);
+
+	void HandleTargetabilityChanged(UTargetPointComponent* TargetPoint);
+	void HandleTargetPointUnregistered(UTargetPointComponent* TargetPoint);
+	void HandleTargetPointMoved(UTargetPointComponent* TargetPoint);
+	/** Returns the valid components watching the TargetPoint. Copied, as handling a change can change the watchers. */
+	TArray<UTargetingSystemComponent*, TInlineAllocator<4>> GetWatchers(const UTargetPointComponent* TargetPoint) const;
+};
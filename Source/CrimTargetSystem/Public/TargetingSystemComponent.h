@@ -3,9 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "TargetPointQueryTypes.h"
+#include "TargetingSystemTypes.h"
+#include "WorldCollision.h"
 #include "Components/ActorComponent.h"
 #include "TargetingSystemComponent.generated.h"
 
+class UTargetIndicatorWidget;
 class UTargetPointFilterBase;
 class UWidgetComponent;
 class UCameraComponent;
@@ -13,6 +17,9 @@ class UTargetPointComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTargetingSystemCompTargetPointSignature, UTargetPointComponent*, NewTarget);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTargetingSystemCompGenericBoolSignature, bool, bEnabled);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FTargetingSystemCompLockedTargetsSignature);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTargetingSystemCompTargetRejectedSignature, UTargetPointComponent*, RejectedTarget);
+DECLARE_DELEGATE_OneParam(FTargetingSystemCompTargetPointsDelegate, const TArray<UTargetPointComponent*>& /*TargetPoints*/);
 
 /**
  * Finds a TargetPointComponent within range to target and attach a widget to it. Can also control the camera and
@@ -23,6 +30,10 @@ class TARGETINGSYSTEM_API UTargetingSystemComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend class UTargetValidationSubsystem;
+	friend struct FLockedTargetContainer;
+	friend struct FTargetingSystemComponentTestAccess;
+
 public:
 	UTargetingSystemComponent();
 
@@ -32,9 +43,44 @@ public:
 	 */
 	UFUNCTION(BlueprintPure, Category = "Targeting System", meta = (AutoCreateRefTerm="Filters"))
 	TArray<UTargetPointComponent*> GetTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters) const;
+
+	/**
+	 * Native version of GetTargetablePoints that also outputs the location of each TargetPoint.
+	 * @param Filters The filter to use to find targets.
+	 * @param OutCandidates Reset and filled with the TargetPoints found.
+	 */
+	void GatherTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters, FTargetPointCandidateList& OutCandidates) const;
+
+	/**
+	 * Native version of GetTargetablePoints that writes into a caller provided array. Pass an array with an inline
+	 * allocator to run the query without allocating.
+	 * @param Filters The filter to use to find targets.
+	 * @param OutTargetPoints Reset and filled with the TargetPoints found.
+	 */
+	template <typename AllocatorType>
+	void GatherTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters, TArray<UTargetPointComponent*, AllocatorType>& OutTargetPoints) const
+	{
+		OutTargetPoints.Reset();
+		OutTargetPoints.Append(GetCandidates(Filters).Points);
+	}
+
+	/**
+	 * Discards the candidates cached by the queries made this frame. The cache already invalidates itself when a
+	 * TargetPoint is registered, unregistered or changes targetability, so this is only needed for changes the
+	 * TargetPointSubsystem can't see, e.g. a filter's properties being edited.
+	 */
+	void InvalidateCandidateCache();
+
+	/**
+	 * Asynchronous version of GetTargetablePoints that also removes the TargetPoints not in line of sight. The line of
+	 * sight traces run on the async trace task, so the result is delivered next frame.
+	 * @param Filters The filter to use to find targets.
+	 * @param OnComplete Called with the TargetPoints found.
+	 */
+	void AsyncGetTargetablePoints(const TArray<UTargetPointFilterBase*>& Filters, FTargetingSystemCompTargetPointsDelegate OnComplete) const;
 	
 	/**
-	 * Finds the target that is closest to the OwnerPawn.
+	 * Finds the target with the best score. With the default ScoreWeights this is the target closest to the OwnerPawn.
 	 * @param Filters TargetPoints to filter out.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Targeting System", meta = (AutoCreateRefTerm="Filters"))
@@ -48,13 +94,25 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Targeting System", meta = (AutoCreateRefTerm="Filters"))
 	UTargetPointComponent* FindNextTarget(UTargetPointComponent* OriginPoint, const TArray<UTargetPointFilterBase*>& Filters, bool bSearchLeft = false) const;
+
+	/** Searches for the targetable point closest on screen to the current target point in the given direction. Use
+	 * it for switching up/down or towards where a gamepad stick is pushed. If there is no current target, will pick
+	 * the target with the best score.
+	 * @param OriginPoint The point to search from.
+	 * @param Filters TargetPoints to filter out.
+	 * @param Direction The direction on screen to search in. X is right, Y is up.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System", meta = (AutoCreateRefTerm="Filters"))
+	UTargetPointComponent* FindTargetInDirection(UTargetPointComponent* OriginPoint, const TArray<UTargetPointFilterBase*>& Filters, FVector2D Direction) const;
 	
 	/**
-	 * Updates the TargetPoint with the passed in value. If Pawn doesn't have authority calls the server version.
+	 * Updates the TargetPoint with the passed in value. If Pawn doesn't have authority the change is applied right away
+	 * and sent to the server with the rest of the frame's targeting changes.
 	 * @param NewTargetPoint Updates the currently selected TargetPoint with the NewTargetPoint.
+	 * @return True if the NewTargetPoint is the TargetedPoint afterwards.
 	 */
 	UFUNCTION(BlueprintCallable, Category="Targeting System")
-	void SetTarget(UTargetPointComponent* NewTargetPoint);
+	bool SetTarget(UTargetPointComponent* NewTargetPoint);
 	
 	/** Clears the currently selected target and unlocks the camera. */
 	UFUNCTION(BlueprintCallable, Category = "Targeting System")
@@ -68,6 +126,37 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Targeting System")
 	UTargetPointComponent* GetTargetedPoint() const;
 	
+	/**
+	 * Replaces the locked target set with the TargetPoints, in order. The first TargetPoint is the primary target.
+	 * TargetPoints that aren't targetable or in range, and any past MaxLockedTargets, are skipped. If Pawn doesn't
+	 * have authority calls the server version.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Multi Lock")
+	void SetLockedTargets(const TArray<UTargetPointComponent*>& TargetPoints);
+
+	/** Adds the TargetPoint at the end of the locked target set, if there is room left. */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Multi Lock")
+	void AddLockedTarget(UTargetPointComponent* TargetPoint);
+
+	/** Removes the TargetPoint from the locked target set. */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Multi Lock")
+	void RemoveLockedTarget(UTargetPointComponent* TargetPoint);
+
+	/** Empties the locked target set. */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Multi Lock")
+	void ClearLockedTargets();
+
+	/**
+	 * Fills the locked target set with the best scoring TargetablePoints, best first, up to MaxLockedTargets.
+	 * @param Filters TargetPoints to filter out.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Targeting System|Multi Lock", meta = (AutoCreateRefTerm="Filters"))
+	void FillLockedTargets(const TArray<UTargetPointFilterBase*>& Filters);
+
+	/** Returns the locked TargetPoints, primary target first. */
+	UFUNCTION(BlueprintPure, Category = "Targeting System|Multi Lock")
+	TArray<UTargetPointComponent*> GetLockedTargets() const;
+
 	/** Toggles between locking and unlocking the camera and rotation. */
 	UFUNCTION(BlueprintCallable, Category = "Targeting System")
 	void ToggleCameraLock();
@@ -79,11 +168,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Targeting System")
 	void SetCameraLock(bool bLock);
 
-	/** Gets if the target is currently locked onto. */
+	/** Gets if the target is currently locked onto. Only replicated to the owning client. */
 	UFUNCTION(BlueprintPure, Category = "Targeting System")
 	bool IsCameraLocked() const;
 	
-	/** Returns the created TargetWidgetComponent that is created on the targeted actor. */
+	/**
+	 * Returns the TargetWidgetComponent attached to the targeted TargetPoint. The same component is reused for every
+	 * target and hidden while there is no target.
+	 */
 	UFUNCTION(BlueprintPure, Category = "Targeting System")
 	UWidgetComponent* GetTargetWidgetComponent() const { return TargetWidgetComponent; }
 	
@@ -98,14 +190,34 @@ public:
 	 */
 	UPROPERTY(BlueprintAssignable, DisplayName = "OnCameraLockSet")
 	FTargetingSystemCompGenericBoolSignature OnCameraLockSetDelegate;
+
+	/** Called when TargetPoints are added to, removed from or reordered in the locked target set. */
+	UPROPERTY(BlueprintAssignable, DisplayName = "OnLockedTargetsChanged")
+	FTargetingSystemCompLockedTargetsSignature OnLockedTargetsChangedDelegate;
+
+	/**
+	 * Called on the owning client when the server rejected the target it predicted. The TargetedPoint has already been
+	 * rolled back to the server's when this is called.
+	 */
+	UPROPERTY(BlueprintAssignable, DisplayName = "OnTargetRejected")
+	FTargetingSystemCompTargetRejectedSignature OnTargetRejectedDelegate;
 	
 	/** Gets the distance between OwnerPawn and InTargetPoint */
+	UFUNCTION(BlueprintPure, Category = "Targeting System")
 	float GetDistanceToPoint(const UTargetPointComponent* InTargetPoint) const;
 
+	/** Gets the squared distance between OwnerPawn and InTargetPoint. Prefer this for comparisons. */
+	float GetDistanceSquaredToPoint(const UTargetPointComponent* InTargetPoint) const;
+
+	/** Returns true if InTargetPoint is within MaxTargetingRange of the OwnerPawn. */
+	bool IsWithinTargetingRange(const UTargetPointComponent* InTargetPoint) const;
+
 	//----------------------------------------------------------------------------------------------------------------
 	// Component Overrides.
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void PreNetReceive() override;
+	virtual void PostRepNotifies() override;
 	virtual void OnRegister() override;
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -118,7 +230,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System")
 	float MaxTargetingRange = 2000.0f;
 
-	/** Frequency to check if the target is in line of sight, within range, and is generally targetable. */
+	/**
+	 * Frequency to check if the target is in line of sight, within range, and is generally targetable. Locally
+	 * controlled players check every frame, and far away owners less often. See UTargetValidationSubsystem.
+	 */
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System")
 	float CheckFrequency = 0.1f;
 	
@@ -126,6 +241,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System")
 	float BreakTargetingDelay = 2.0f;
 
+	/** How the line of sight to the targeted point is checked. */
+	UPROPERTY(EditDefaultsOnly, Category = "Targeting System")
+	ETargetingLineOfSightMode LineOfSightMode = ETargetingLineOfSightMode::Shared;
+
 	/** Whether to accept pitch input when bAdjustPitchBasedOnDistanceToTarget is disabled */
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System")
 	bool bIgnoreLookInput = true;
@@ -138,12 +257,31 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Rotation", meta = (EditCondition="bForceOrientRotationToLockOnTarget"))
 	float PawnInterpSpeed = 25.0f;
 
+	/** The maximum number of TargetPoints in the locked target set. */
+	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Multi Lock", meta = (ClampMin = 1))
+	int32 MaxLockedTargets = 4;
+
+	/** The half angle, on screen, around the search direction that FindTargetInDirection accepts targets in. */
+	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Switching", meta = (ClampMin = 0, ClampMax = 90))
+	float DirectionalSwitchHalfAngle = 45.0f;
+
 	/**
 	 * The Widget Class to use when spawning a targeting widget. If empty, fallback to using the default in settings.
 	 */
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Widget")
 	TSubclassOf<UUserWidget> TargetWidgetClass;
 
+	/**
+	 * Screen space widget that marks every candidate the CandidateIndicatorFilters let through, e.g. for soft lock
+	 * markers. Created for the local player only. If empty, candidates are not marked.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Widget")
+	TSubclassOf<UTargetIndicatorWidget> CandidateIndicatorClass;
+
+	/** The filters used to find the candidates marked by the CandidateIndicatorClass. */
+	UPROPERTY(EditDefaultsOnly, Instanced, Category = "Targeting System|Widget")
+	TArray<TObjectPtr<UTargetPointFilterBase>> CandidateIndicatorFilters;
+
 	/**
 	 * Setting this to true will tell the Targeting System to adjust the Pitch Offset (the Y axis) when locked on,
 	 * depending on the distance to the target actor.
@@ -166,12 +304,60 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Pitch Offset")
 	float PitchMax = -20.0f;
+
+	/** How candidates are scored when picking a target. Lower scores are preferred. */
+	UPROPERTY(EditDefaultsOnly, Category = "Targeting System|Scoring")
+	FTargetPointScoreWeights ScoreWeights;
+
+	/**
+	 * Scores each candidate using the ScoreWeights. Lower scores are preferred. Override to customize target selection.
+	 * @param Candidates The candidates to score.
+	 * @param OutScores Filled with the score of each candidate. Has the same number of elements as the Candidates.
+	 */
+	virtual void ScoreCandidates(const FTargetPointCandidateList& Candidates, TArrayView<float> OutScores) const;
+
+	/** Returns the index of the candidate with the lowest score. INDEX_NONE if there are no candidates. */
+	int32 SelectBestCandidate(const FTargetPointCandidateList& Candidates) const;
+
+	/**
+	 * Returns the filtered candidates within range. Queries made in the same frame, from the same location and with
+	 * the same Filters share one result. The result stays valid until NumCandidateCacheEntries other filter sets have
+	 * been queried.
+	 */
+	const FTargetPointCandidateList& GetCandidates(const TArray<UTargetPointFilterBase*>& Filters) const;
 	
 	virtual void OnTargetedPointSet();
 	virtual void OnClearTarget();
 	virtual void OnCameraLockSet();
 
 private:
+	/** The result of a GetCandidates call and what it was computed from. */
+	struct FCandidateCacheEntry
+	{
+		FTargetPointCandidateList Candidates;
+		TArray<const UTargetPointFilterBase*, TInlineAllocator<8>> Filters;
+		uint64 Frame = MAX_uint64;
+		/** GetCandidates call that last used this entry, to evict the least recently used one. */
+		uint64 LastUsed = 0;
+		FVector Origin = FVector::ZeroVector;
+		float Range = 0.f;
+		uint32 Revision = 0;
+
+		bool Matches(TConstArrayView<UTargetPointFilterBase*> InFilters) const
+		{
+			return Filters.Num() == InFilters.Num()
+				&& FMemory::Memcmp(Filters.GetData(), InFilters.GetData(), Filters.Num() * sizeof(UTargetPointFilterBase*)) == 0;
+		}
+	};
+
+	/**
+	 * One entry per filter set queried in a frame. Input handling and the candidate indicator query with different
+	 * filters every frame, so a single entry would evict itself.
+	 */
+	static constexpr int32 NumCandidateCacheEntries = 4;
+	mutable FCandidateCacheEntry CandidateCache[NumCandidateCacheEntries];
+	mutable uint64 CandidateCacheUses = 0;
+
 	/** Cached value of whether our owner is a simulated Actor. */
 	UPROPERTY()
 	bool bCachedIsNetSimulated = false;
@@ -186,10 +372,54 @@ private:
 	FTimerHandle BreakTargetPointTimerHandle;
 	UPROPERTY()
 	bool bIsBreakingLineOfSight;
+	/** The pending async line of sight trace when LineOfSightMode is Asynchronous. */
+	FTraceHandle LineOfSightTraceHandle;
+	/** The TargetPoint watched with the TargetLineOfSightSubsystem when LineOfSightMode is Shared. */
+	UPROPERTY()
+	TObjectPtr<UTargetPointComponent> LineOfSightWatchedPoint;
 	
+	/**
+	 * Set by the TargetValidationSubsystem when a watched TargetPoint moved, so the range is checked on its next tick.
+	 */
+	bool bTargetRangeCheckPending = false;
+
+	/**
+	 * Validates the TargetedPoint, line of sight included, and the locked target set. Used when there is no
+	 * TargetValidationSubsystem.
+	 */
+	void ValidateTargets();
+	/** Registers for validation while there is a target or locked target, unregisters otherwise. */
+	void UpdateValidationRegistration();
+
 	void CheckTargetPoint();
-	bool ShouldBreakTargeting() const;
+	/**
+	 * Checks the targetability and range of the TargetedPoint, and of the locked targets on authority. Called by the
+	 * TargetValidationSubsystem when either end moved or a target changed.
+	 */
+	void CheckTargetRange();
+	/** Checks the line of sight to the TargetedPoint. Polled by the TargetValidationSubsystem. */
+	void CheckTargetLineOfSight();
+	/**
+	 * Drops the TargetPoint from the target and the locked target set if it is no longer targetable. Called when its
+	 * targetability changes.
+	 */
+	void HandleWatchedTargetabilityChanged(UTargetPointComponent* TargetPoint);
+	/** Drops the TargetPoint from the target and the locked target set. Called when it is unregistered. */
+	void HandleWatchedTargetPointRemoved(UTargetPointComponent* TargetPoint);
+	/** Checks if the TargetedPoint is gone, untargetable or out of range. Line of sight is checked separately. */
+	bool ShouldBreakTargetingIgnoringLineOfSight() const;
+	void StartBreakingTargeting();
 	void BreakTargeting();
+
+	FCollisionQueryParams GetLineOfSightQueryParams() const;
+	bool IsLineOfSightBlocked(const FVector& TargetLocation) const;
+	FTraceHandle AsyncTraceLineOfSight(const FVector& TargetLocation, const FTraceDelegate& OnComplete) const;
+	void OnCheckTargetPointTraceComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void OnBreakTargetingTraceComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	/** Returns the last result of the TargetLineOfSightSubsystem for the TargetedPoint. */
+	bool IsSharedLineOfSightBlocked() const;
+	/** Moves the shared line of sight watch to the current TargetedPoint. */
+	void UpdateLineOfSightWatch();
 	
 	//~ Actor rotation
 
@@ -204,8 +434,17 @@ private:
 	/** Sets the owning player's character movement component OrientRotationToMovement. */
 	void SetOrientRotationToMovement(bool bOrientRotationToMovement) const;
 	
-	/** Attaches a widget to the component. */
+	/** Attaches the TargetWidgetComponent to the TargetPoint and shows it, creating it the first time. */
 	void CreateAndAttachTargetSelectedWidgetComponent(UTargetPointComponent* InTargetPoint);
+
+	/** Hides the TargetWidgetComponent and detaches it from the target. The component is kept for the next target. */
+	void HideTargetWidgetComponent();
+
+	/** Picks up the default TargetWidgetClass once it has streamed in, and creates the widget if a target is set. */
+	void HandleDefaultTargetWidgetClassLoaded();
+
+	/** Passes the current candidates to the CandidateIndicator, creating it the first time. */
+	void UpdateCandidateIndicator();
 	
 	/**
 	 *  Sets up cached Owner PlayerController from Owner Pawn.
@@ -222,24 +461,94 @@ private:
 	TObjectPtr<UCameraComponent> CameraComponent;
 	UPROPERTY()
 	TObjectPtr<UWidgetComponent> TargetWidgetComponent;
+	UPROPERTY()
+	TObjectPtr<UTargetIndicatorWidget> CandidateIndicator;
 	
 	UPROPERTY(ReplicatedUsing = OnRep_TargetedPoint)
 	TObjectPtr<UTargetPointComponent> TargetedPoint;
 	UFUNCTION()
-	void OnRep_TargetedPoint();
+	void OnRep_TargetedPoint(UTargetPointComponent* OldTargetedPoint);
+	/** Sets the TargetedPoint, runs the set or clear logic and broadcasts OnTargetedPointUpdated. */
+	void ApplyTargetedPoint(UTargetPointComponent* NewTargetPoint);
+
+	//~ Target prediction. The owning client applies target and camera lock changes immediately and sends the state at
+	//~ the end of the frame to the server in one unreliable request, keyed so the server only processes newer requests.
+	//~ The server acknowledges the key it processed; if its state differs from the prediction at that point, the
+	//~ client rolls back to it. The OnReps only record what was received, the reconciliation runs in PostRepNotifies
+	//~ once the whole update is in, whatever order the properties arrived in. Simulated proxies never predict.
+
+	/** The latest TargetedPoint received from the server. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTargetPointComponent> ConfirmedTargetedPoint;
+	/** The latest bCameraLocked received from the server. */
+	bool bConfirmedCameraLocked = false;
+	/** True when the update being received contains the TargetedPoint, bCameraLocked or the acknowledged key. */
+	bool bTargetingStateReceived = false;
+	/** True when the update being received contains the acknowledged key. */
+	bool bTargetPredictionAcknowledged = false;
+	/** The owning client's latest request. */
+	UPROPERTY(Transient)
+	FTargetingStateRequest PredictedState;
+	/** The key of the owning client's latest request. */
+	uint16 TargetPredictionKey = 0;
+	/** The key of the latest request the server processed. */
+	UPROPERTY(ReplicatedUsing = OnRep_AcknowledgedTargetPredictionKey)
+	uint16 AcknowledgedTargetPredictionKey = 0;
+	UFUNCTION()
+	void OnRep_AcknowledgedTargetPredictionKey();
+	/** True when the state changed this frame and has to be sent. */
+	bool bTargetingStateDirty = false;
+	/** When the latest request was last sent. */
+	double LastTargetingStateRequestTime = 0.0;
+
+	bool HasPendingTargetPrediction() const { return TargetPredictionKey != AcknowledgedTargetPredictionKey; }
+	/** Returns true on the owning client, whose pawn is an autonomous proxy. Only it predicts and sends requests. */
+	bool IsPredictingTargetingState() const;
+	/**
+	 * Called before the target or camera lock changes. Returns false on simulated proxies, which only apply the state
+	 * replicated from the server. Marks the state dirty on the owning client.
+	 */
+	bool PrepareTargetingStateChange();
+	/** Returns true if Key was made after OtherKey. Handles wrapping. */
+	static bool IsNewerTargetPredictionKey(uint16 Key, uint16 OtherKey) { return static_cast<int16>(Key - OtherKey) > 0; }
+	/** Marks the owning client's state for sending on the next tick. Changes until then share the same request. */
+	void MarkTargetingStateDirty();
+	/** Sends the state if it changed this frame, or resends the latest request if it has waited too long for an acknowledgement. */
+	void UpdateTargetingStateRequest();
+	/** Applies the server's state once no request is waiting for an acknowledgement. */
+	void ReconcileTargetingState();
+	/**
+	 * Applies the owning client's request if it was accepted and acknowledges it. Server only, called once the
+	 * TargetValidationSubsystem has validated the request.
+	 * @return True if the requested target and camera lock were applied.
+	 */
+	bool ResolveTargetingStateRequest(const FTargetingStateRequest& Request, bool bAccepted);
 	
 	UPROPERTY(ReplicatedUsing = OnRep_CameraLocked)
 	bool bCameraLocked = false;
 	UFUNCTION()
-	void OnRep_CameraLocked();
+	void OnRep_CameraLocked(bool bOldCameraLocked);
+	/** Sets bCameraLocked, runs the lock logic and broadcasts OnCameraLockSet. */
+	void ApplyCameraLock(bool bLock);
+
+	UPROPERTY(Replicated)
+	FLockedTargetContainer LockedTargets;
+	/** Called on clients when an update to the LockedTargets is received. */
+	void OnRep_LockedTargets();
+	/** Returns true if the TargetPoint can stay in, or be added to, the locked target set. */
+	bool IsLockedTargetValid(const UTargetPointComponent* TargetPoint) const;
+	/** Removes the locked targets that are no longer valid. Authority only. */
+	void ValidateLockedTargets();
 
 	UFUNCTION()
 	void OnTargetPointOwnerDestroyed(AActor* DestroyedActor);
 
+	UFUNCTION(Server, Unreliable)
+	void Server_RequestTargetingState(const FTargetingStateRequest& Request);
 	UFUNCTION(Server, Reliable)
-	void Server_SetCameraLock(bool bLocked);
+	void Server_SetLockedTargets(const TArray<UTargetPointComponent*>& TargetPoints);
 	UFUNCTION(Server, Reliable)
-	void Server_ClearTarget();
+	void Server_AddLockedTarget(UTargetPointComponent* TargetPoint);
 	UFUNCTION(Server, Reliable)
-	void Server_SetTarget(UTargetPointComponent* NewTargetPoint);
+	void Server_RemoveLockedTarget(UTargetPointComponent* TargetPoint);
 };
@@ -23,5 +23,73 @@ public:
 	UPROPERTY(Config, EditAnywhere)
 	TSoftClassPtr<UUserWidget> TargetWidgetClass;
 
+	/**
+	 * The size of a cell in the grid used to look up TargetPoints by location. Works best when it matches the
+	 * MaxTargetingRange of the TargetingSystemComponents.
+	 */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 100))
+	float TargetPointGridCellSize = 2000.f;
+
+	/** The maximum number of shared line of sight traces done each frame. See UTargetLineOfSightSubsystem. */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 1))
+	int32 LineOfSightTracesPerFrame = 32;
+
+	/**
+	 * Microseconds per frame the TargetValidationSubsystem may spend validating targets. Locally controlled players
+	 * are always validated and don't wait on the budget.
+	 */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	float ValidationBudgetMicroseconds = 250.f;
+
+	/** Owners within this distance of a player's view validate their target at their CheckFrequency. */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	float ValidationNearDistance = 3000.f;
+
+	/**
+	 * Owners within this distance of a player's view, but outside ValidationNearDistance, validate their target every
+	 * FarValidationInterval. Owners further away are dormant and validate every DormantValidationInterval.
+	 */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	float ValidationFarDistance = 10000.f;
+
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	float FarValidationInterval = 0.5f;
+
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	float DormantValidationInterval = 2.f;
+
+	/**
+	 * How far a TargetPoint or a targeting owner has to move before the targeting range is checked again. Line of sight
+	 * is still polled at the validation intervals.
+	 */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	float TargetMoveThreshold = 50.f;
+
+	/**
+	 * Seconds the owning client waits for the server to acknowledge a targeting state change before sending it again.
+	 * Target and camera lock changes are sent unreliably, only the latest state is ever resent.
+	 */
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0.05))
+	float TargetRequestResendInterval = 0.25f;
+
+	/**
+	 * Returns the default TargetWidgetClass if it is loaded, null otherwise. Never loads the class, see
+	 * LoadDefaultTargetWidgetClass.
+	 */
 	static TSubclassOf<UUserWidget> GetDefaultTargetWidgetClass();
+
+	/**
+	 * Starts streaming in the default TargetWidgetClass without blocking. Does nothing if it is already loaded or
+	 * loading. Called whenever a game world is initialized.
+	 */
+	static void LoadDefaultTargetWidgetClass();
+
+	/** Returns true while the default TargetWidgetClass is streaming in. */
+	static bool IsLoadingDefaultTargetWidgetClass();
+
+	/** Cancels streaming in the default TargetWidgetClass, or lets it unload once loaded. Called on module shutdown. */
+	static void ReleaseDefaultTargetWidgetClass();
+
+	/** Broadcast when the default TargetWidgetClass finishes streaming in. */
+	static FSimpleMulticastDelegate OnDefaultTargetWidgetClassLoaded;
 };
@@ -0,0 +1,7 @@
+﻿// Copyright Soccertitan 2025
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("TargetingSystem"), STATGROUP_TargetingSystem, STATCAT_Advanced);
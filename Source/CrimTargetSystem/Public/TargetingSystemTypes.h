@@ -10,6 +10,7 @@
 
 class UTargetPointManagerComponent;
 class UTargetPointComponent;
+class UTargetingSystemComponent;
 
 USTRUCT(BlueprintType)
 struct TARGETINGSYSTEM_API FTargetPointItem : public FFastArraySerializerItem
@@ -29,6 +30,46 @@ struct TARGETINGSYSTEM_API FTargetPointItem : public FFastArraySerializerItem
 	TObjectPtr<UTargetPointComponent> TargetPointComponent;
 };
 
+/** How a TargetingSystemComponent checks the line of sight to its targeted point. */
+UENUM(BlueprintType)
+enum class ETargetingLineOfSightMode : uint8
+{
+	/** Traces on the game thread every time the target is checked. */
+	Synchronous,
+	/** Issues an async trace and uses its result the next frame. */
+	Asynchronous,
+	/** Uses the budgeted, de-duplicated traces of the TargetLineOfSightSubsystem. */
+	Shared
+};
+
+/**
+ * Weights used by the TargetingSystemComponent to score TargetPoints when picking a target. Lower scores are
+ * preferred. Every term is computed without square roots or trigonometry.
+ */
+USTRUCT(BlueprintType)
+struct TARGETINGSYSTEM_API FTargetPointScoreWeights
+{
+	GENERATED_BODY()
+
+	/** Weight of the squared distance to the TargetPoint, normalized by the squared MaxTargetingRange. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Distance = 1.f;
+
+	/**
+	 * Weight of how far the TargetPoint is from the centre of the screen. Goes from 0 in the view direction, to 1 at
+	 * 90 degrees off the view direction, to 2 directly behind the camera.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ScreenCenterOffset = 0.f;
+
+	/** Subtracted from the score of TargetPoints whose TargetPointTag exactly matches the key. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TMap<FGameplayTag, float> TagPriority;
+
+	/** True when only the distance contributes to the score. */
+	bool IsDistanceOnly() const { return ScreenCenterOffset == 0.f && TagPriority.IsEmpty(); }
+};
+
 USTRUCT(BlueprintType)
 struct TARGETINGSYSTEM_API FTargetPointContainer : public FFastArraySerializer
 {
@@ -55,9 +96,122 @@ private:
 	// Replicated list of TargetPoints.
 	UPROPERTY()
 	TArray<FTargetPointItem> Items;
+
+	/** The component owning this container. Applies replicated changes to the TargetPoints. Set on register. */
+	UPROPERTY(NotReplicated, Transient)
+	TObjectPtr<UTargetPointManagerComponent> Owner;
 };
 template<>
 struct TStructOpsTypeTraits<FTargetPointContainer> : TStructOpsTypeTraitsBase2<FTargetPointContainer>
 {
 	enum { WithNetDeltaSerializer = true };
 };
+
+/**
+ * The targetability of the TargetPoints of a TargetPointManagerComponent using compact replication. One bit per
+ * TargetPoint, in the order of the manager's layout. Serialized by FTargetPointTargetableMaskNetSerializer with Iris.
+ */
+USTRUCT()
+struct TARGETINGSYSTEM_API FTargetPointTargetableMask
+{
+	GENERATED_BODY()
+
+	/** Masks with more bits are rejected when received. */
+	static constexpr int32 MaxNumBits = 1024;
+
+	TBitArray<> Bits;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+	bool Identical(const FTargetPointTargetableMask* Other, uint32 PortFlags) const { return Bits == Other->Bits; }
+};
+template<>
+struct TStructOpsTypeTraits<FTargetPointTargetableMask> : TStructOpsTypeTraitsBase2<FTargetPointTargetableMask>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdentical = true
+	};
+};
+
+/**
+ * The targeting state the owning client of a TargetingSystemComponent asks the server for. Every change made in a frame
+ * is sent together in one of these. Plain properties replicate compactly enough: the TargetPoint as a packed NetGUID,
+ * the lock as one bit.
+ */
+USTRUCT()
+struct TARGETINGSYSTEM_API FTargetingStateRequest
+{
+	GENERATED_BODY()
+
+	/** The TargetPoint to target. Null clears the target. */
+	UPROPERTY()
+	TObjectPtr<UTargetPointComponent> TargetPoint;
+
+	UPROPERTY()
+	bool bCameraLocked = false;
+
+	/** Increases with every request. The server only processes requests newer than the last one it processed. */
+	UPROPERTY()
+	uint16 PredictionKey = 0;
+};
+
+/** A TargetPoint in a TargetingSystemComponent's locked target set. */
+USTRUCT(BlueprintType)
+struct TARGETINGSYSTEM_API FLockedTargetItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** The locked TargetPoint. */
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<UTargetPointComponent> TargetPoint;
+
+	/** The position of the TargetPoint in the locked target set. The lowest is the primary target. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 LockOrder = 0;
+};
+
+/**
+ * The ordered set of TargetPoints a TargetingSystemComponent is locked onto. Only the locks that were added, removed
+ * or reordered are replicated.
+ */
+USTRUCT(BlueprintType)
+struct TARGETINGSYSTEM_API FLockedTargetContainer : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	FLockedTargetContainer()
+	{}
+
+	const TArray<FLockedTargetItem>& GetAllItems() const { return Items; }
+	int32 Num() const { return Items.Num(); }
+	bool IsEmpty() const { return Items.IsEmpty(); }
+
+	/** Fills OutTargetPoints with the locked TargetPoints, primary target first. */
+	void GetTargetPoints(TArray<UTargetPointComponent*>& OutTargetPoints) const;
+
+	//~FFastArraySerializer contract
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+	//~End of FFastArraySerializer contract
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FastArrayDeltaSerialize<FLockedTargetItem, FLockedTargetContainer>(Items, DeltaParams, *this);
+	}
+
+private:
+	friend UTargetingSystemComponent;
+
+	// Replicated list of locked TargetPoints. Not sorted, see LockOrder.
+	UPROPERTY()
+	TArray<FLockedTargetItem> Items;
+
+	/** The component owning this container. Notified when a replicated update is received. Set on register. */
+	UPROPERTY(NotReplicated, Transient)
+	TObjectPtr<UTargetingSystemComponent> Owner;
+};
+template<>
+struct TStructOpsTypeTraits<FLockedTargetContainer> : TStructOpsTypeTraitsBase2<FLockedTargetContainer>
+{
+	enum { WithNetDeltaSerializer = true };
+};
@@ -14,7 +14,8 @@ public class TargetingSystem : ModuleRules
 				"Core",
 				"GameplayTags",
 				"NetCore",
-				"DeveloperSettings"
+				"DeveloperSettings",
+				"UMG"
 			}
 			);
 			
@@ -24,14 +25,16 @@ public class TargetingSystem : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
-				"UMG",
 				"Slate",
 				"SlateCore",
 				"GameplayTags", 
-				"CrimBlueprintStatics",
+				"IrisCore",
 			}
 			);
 		
+		// Defines UE_WITH_IRIS for targets replicating with Iris.
+		SetupIrisSupport(Target);
+		
 		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]